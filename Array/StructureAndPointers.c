@@ -1,4 +1,8 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
 
 // Define a structure
 struct Person {
@@ -11,7 +15,7 @@ void modifyPerson(struct Person *p) {
     // Modifying the values of the structure using pointer
     // *p means we are accessing the actual structure in memory (not a copy)
     printf("Modifying values...\n");
-    
+
     // Changing name and age using the pointer
     // Here, p->name and p->age are equivalent to (*p).name and (*p).age
     // We are modifying the actual values stored in memory
@@ -19,7 +23,309 @@ void modifyPerson(struct Person *p) {
     p->age = 30;  // Changing the age to 30
 }
 
-int main() {
+// ---------------------------------------------------------------------------
+// Column store for many people
+// ---------------------------------------------------------------------------
+
+// An array of struct Person keeps each name next to its age, so a loop that
+// only reads ages still pulls 56 bytes per person through the cache for the 4
+// it uses. PersonTable keeps one array per field instead ("struct of
+// arrays"): all ages are contiguous, and the loops over them below can be
+// vectorized.
+//
+// Names are packed back to back, each ending in '\0', in one character
+// buffer; nameOffsets[i] is where person i's name starts. Renaming appends
+// the new name and leaves the old bytes as garbage until tableCompactNames.
+
+#define TABLE_INITIAL_CAPACITY 16
+#define NAMES_INITIAL_BYTES 256
+
+struct PersonTable {
+    int* ages;
+    uint32_t* nameOffsets;
+    char* names;
+    size_t namesUsed;
+    size_t namesCapacity;
+    int count;
+    int capacity;
+};
+
+void tableInit(struct PersonTable* t) {
+    t->ages = NULL;
+    t->nameOffsets = NULL;
+    t->names = NULL;
+    t->namesUsed = 0;
+    t->namesCapacity = 0;
+    t->count = 0;
+    t->capacity = 0;
+}
+
+void tableDestroy(struct PersonTable* t) {
+    free(t->ages);
+    free(t->nameOffsets);
+    free(t->names);
+    tableInit(t);
+}
+
+// Make room for at least `rows` people
+int tableReserve(struct PersonTable* t, int rows) {
+    if (rows <= t->capacity) return 0;
+    int capacity = t->capacity > 0 ? t->capacity : TABLE_INITIAL_CAPACITY;
+    while (capacity < rows) capacity *= 2;
+    int* ages = (int*)realloc(t->ages, (size_t)capacity * sizeof(int));
+    if (ages == NULL) return -1;
+    t->ages = ages;
+    uint32_t* offsets = (uint32_t*)realloc(t->nameOffsets, (size_t)capacity * sizeof(uint32_t));
+    if (offsets == NULL) return -1;
+    t->nameOffsets = offsets;
+    t->capacity = capacity;
+    return 0;
+}
+
+// Copy name into the name buffer; returns its offset, or -1
+static long long appendName(struct PersonTable* t, const char* name) {
+    size_t length = strlen(name) + 1;
+    if (t->namesUsed + length > UINT32_MAX) return -1;
+    if (t->namesUsed + length > t->namesCapacity) {
+        size_t capacity = t->namesCapacity > 0 ? t->namesCapacity : NAMES_INITIAL_BYTES;
+        while (capacity < t->namesUsed + length) capacity *= 2;
+        char* names = (char*)realloc(t->names, capacity);
+        if (names == NULL) return -1;
+        t->names = names;
+        t->namesCapacity = capacity;
+    }
+    memcpy(t->names + t->namesUsed, name, length);
+    t->namesUsed += length;
+    return (long long)(t->namesUsed - length);
+}
+
+// Add a person at the end; returns the row number or -1
+int tableAppend(struct PersonTable* t, const char* name, int age) {
+    if (tableReserve(t, t->count + 1) != 0) return -1;
+    long long offset = appendName(t, name);
+    if (offset < 0) return -1;
+    t->ages[t->count] = age;
+    t->nameOffsets[t->count] = (uint32_t)offset;
+    return t->count++;
+}
+
+const char* tableName(const struct PersonTable* t, int row) {
+    return t->names + t->nameOffsets[row];
+}
+
+int tableRename(struct PersonTable* t, int row, const char* name) {
+    long long offset = appendName(t, name);
+    if (offset < 0) return -1;
+    t->nameOffsets[row] = (uint32_t)offset;
+    return 0;
+}
+
+// Rewrite the name buffer without the bytes left behind by tableRename
+int tableCompactNames(struct PersonTable* t) {
+    char* names = (char*)malloc(t->namesUsed > 0 ? t->namesUsed : 1);
+    if (names == NULL) return -1;
+    size_t used = 0;
+    for (int i = 0; i < t->count; i++) {
+        size_t length = strlen(t->names + t->nameOffsets[i]) + 1;
+        memcpy(names + used, t->names + t->nameOffsets[i], length);
+        t->nameOffsets[i] = (uint32_t)used;
+        used += length;
+    }
+    free(t->names);
+    t->names = names;
+    t->namesUsed = used;
+    t->namesCapacity = t->namesUsed > 0 ? t->namesUsed : 1;
+    return 0;
+}
+
+// Struct of arrays from an array of structs (appended to whatever t holds)
+int tableFromPeople(struct PersonTable* t, const struct Person* people, int n) {
+    if (tableReserve(t, t->count + n) != 0) return -1;
+    for (int i = 0; i < n; i++) {
+        if (tableAppend(t, people[i].name, people[i].age) < 0) return -1;
+    }
+    return 0;
+}
+
+// Array of structs from the table; out must hold t->count people. Names
+// longer than struct Person allows are cut short.
+void tableToPeople(const struct PersonTable* t, struct Person* out) {
+    for (int i = 0; i < t->count; i++) {
+        snprintf(out[i].name, sizeof(out[i].name), "%s", tableName(t, i));
+        out[i].age = t->ages[i];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Batch kernels over the age column. Plain loops over restrict pointers with
+// no early exits: gcc -O3 and clang -O2 vectorize add, count and sum; the
+// filter stays scalar but has no branches.
+// ---------------------------------------------------------------------------
+
+// Add delta to every age
+void tableAddToAges(struct PersonTable* t, int delta) {
+    int* restrict ages = t->ages;
+    int n = t->count;
+    for (int i = 0; i < n; i++) ages[i] += delta;
+}
+
+// Number of people with lo <= age <= hi
+int tableCountAgeRange(const struct PersonTable* t, int lo, int hi) {
+    const int* restrict ages = t->ages;
+    int n = t->count;
+    int count = 0;
+    for (int i = 0; i < n; i++) count += ages[i] >= lo && ages[i] <= hi;
+    return count;
+}
+
+long long tableSumAges(const struct PersonTable* t) {
+    const int* restrict ages = t->ages;
+    int n = t->count;
+    long long sum = 0;
+    for (int i = 0; i < n; i++) sum += ages[i];
+    return sum;
+}
+
+// Write the rows with lo <= age <= hi to rows (room for t->count entries);
+// returns how many. Every row index is stored and the cursor advances only
+// on a match, so the loop has no branch to mispredict.
+int tableFilterAgeRange(const struct PersonTable* t, int lo, int hi, int* restrict rows) {
+    const int* restrict ages = t->ages;
+    int n = t->count;
+    int found = 0;
+    for (int i = 0; i < n; i++) {
+        rows[found] = i;
+        found += ages[i] >= lo && ages[i] <= hi;
+    }
+    return found;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: the same age scans over an array of struct Person and over the
+// table
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void addToAgesAoS(struct Person* people, int n, int delta) {
+    for (int i = 0; i < n; i++) people[i].age += delta;
+}
+
+static int countAgeRangeAoS(const struct Person* people, int n, int lo, int hi) {
+    int count = 0;
+    for (int i = 0; i < n; i++) count += people[i].age >= lo && people[i].age <= hi;
+    return count;
+}
+
+static long long sumAgesAoS(const struct Person* people, int n) {
+    long long sum = 0;
+    for (int i = 0; i < n; i++) sum += people[i].age;
+    return sum;
+}
+
+static int filterAgeRangeAoS(const struct Person* people, int n, int lo, int hi, int* rows) {
+    int found = 0;
+    for (int i = 0; i < n; i++) {
+        rows[found] = i;
+        found += people[i].age >= lo && people[i].age <= hi;
+    }
+    return found;
+}
+
+#define BENCH_PASSES 5
+
+static void runBenchmark(int n) {
+    struct Person* people = (struct Person*)malloc((size_t)n * sizeof(struct Person));
+    int* rows = (int*)malloc((size_t)n * sizeof(int));
+    struct PersonTable table;
+    tableInit(&table);
+    if (people == NULL || rows == NULL) {
+        free(people);
+        free(rows);
+        return;
+    }
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < n; i++) {
+        snprintf(people[i].name, sizeof(people[i].name), "Person %d", i);
+        people[i].age = (int)(nextRandom(&seed) % 100);
+    }
+    double t0 = nowSeconds();
+    if (tableFromPeople(&table, people, n) != 0) {
+        free(people);
+        free(rows);
+        tableDestroy(&table);
+        return;
+    }
+    double convert = nowSeconds() - t0;
+
+    printf("%d people: %zu bytes per row as structs, %zu as columns (+ names)\n", n, sizeof(struct Person),
+           sizeof(int) + sizeof(uint32_t));
+    printf("array of structs -> table: %.1f ms\n", convert * 1e3);
+    printf("%-22s %12s %12s %9s\n", "ns per row (best of 5)", "structs", "columns", "speedup");
+
+    const char* names[] = {"sum ages", "count 18 <= age <= 65", "filter 18 <= age <= 65", "add 1 to every age"};
+    for (int kernel = 0; kernel < 4; kernel++) {
+        double best[2] = {1e30, 1e30};
+        long long results[2] = {0, 0};
+        for (int pass = 0; pass < BENCH_PASSES; pass++) {
+            for (int layout = 0; layout < 2; layout++) {
+                long long result = 0;
+                double start = nowSeconds();
+                switch (kernel) {
+                    case 0:
+                        result = layout == 0 ? sumAgesAoS(people, n) : tableSumAges(&table);
+                        break;
+                    case 1:
+                        result = layout == 0 ? countAgeRangeAoS(people, n, 18, 65) : tableCountAgeRange(&table, 18, 65);
+                        break;
+                    case 2:
+                        result = layout == 0 ? filterAgeRangeAoS(people, n, 18, 65, rows)
+                                             : tableFilterAgeRange(&table, 18, 65, rows);
+                        break;
+                    default:
+                        // +1 then -1 on alternate passes so the ages stay put
+                        if (layout == 0) {
+                            addToAgesAoS(people, n, pass % 2 ? -1 : 1);
+                        } else {
+                            tableAddToAges(&table, pass % 2 ? -1 : 1);
+                        }
+                        result = layout == 0 ? people[n - 1].age : table.ages[n - 1];
+                        break;
+                }
+                double elapsed = nowSeconds() - start;
+                if (elapsed < best[layout]) best[layout] = elapsed;
+                results[layout] = result;
+            }
+        }
+        printf("%-22s %12.3f %12.3f %8.1fx%s\n", names[kernel], best[0] * 1e9 / n, best[1] * 1e9 / n,
+               best[0] / best[1], results[0] == results[1] ? "" : "  (results differ)");
+    }
+
+    free(people);
+    free(rows);
+    tableDestroy(&table);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [people]
+        int n = argc > 2 ? atoi(argv[2]) : 2000000;
+        if (n < 1) n = 1;
+        runBenchmark(n);
+        return 0;
+    }
+
     // Create a structure variable and initialize it
     struct Person person1 = {"John", 25};
 
@@ -33,5 +339,24 @@ int main() {
     // The values are modified because the structure was passed by reference (pointer)
     printf("After modification: Name = %s, Age = %d\n", person1.name, person1.age);
 
+    // The same records as columns
+    struct Person people[] = {{"John", 25}, {"Maria", 41}, {"Wei", 16}, {"Amara", 63}};
+    struct PersonTable table;
+    tableInit(&table);
+    tableFromPeople(&table, people, 4);
+    tableRename(&table, 0, "Alice");
+    tableAddToAges(&table, 1);   // Everyone has a birthday
+    tableCompactNames(&table);
+
+    int rows[4];
+    int found = tableFilterAgeRange(&table, 18, 65, rows);
+    printf("Adults:");
+    for (int i = 0; i < found; i++) printf(" %s (%d)", tableName(&table, rows[i]), table.ages[rows[i]]);   // Alice (26) Maria (42) Amara (64)
+    printf("\n");
+
+    tableToPeople(&table, people);
+    printf("Back to structs: %s is %d\n", people[3].name, people[3].age);   // Amara is 64
+    tableDestroy(&table);
+
     return 0;
 }
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "NodePool.h"
 
 struct Node {
     int data;
@@ -8,21 +9,59 @@ struct Node {
 
 struct CircularLinkedList {
     struct Node* head;
+    struct Node* tail;     // Last node, its next is head
+    int length;
+    struct NodePool pool;  // Nodes are allocated from the list's own pool
 };
 
+void initList(struct CircularLinkedList* list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    poolInit(&list->pool, sizeof(struct Node), POOL_DEFAULT_SLAB_NODES);
+}
+
+// Free every node of the list at once by releasing the pool's slabs
+void list_destroy(struct CircularLinkedList* list) {
+    poolDestroy(&list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+}
+
 void insert(struct CircularLinkedList* list, int data) {
-    struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
+    struct Node* newNode = (struct Node*)poolAlloc(&list->pool);
+    if (newNode == NULL) return;
     newNode->data = data;
     if (list->head == NULL) {
         list->head = newNode;
-        newNode->next = list->head;
     } else {
-        struct Node* temp = list->head;
-        while (temp->next != list->head) {
-            temp = temp->next;
+        // Append after the tail in O(1) instead of walking around the circle
+        list->tail->next = newNode;
+    }
+    newNode->next = list->head;
+    list->tail = newNode;
+    list->length++;
+}
+
+// Build a circular list from an array in one pass (the list must be initialized and empty)
+void list_from_array(struct CircularLinkedList* list, const int* values, int n) {
+    struct Node* last = NULL;
+    for (int i = 0; i < n; i++) {
+        struct Node* newNode = (struct Node*)poolAlloc(&list->pool);
+        if (newNode == NULL) break;
+        newNode->data = values[i];
+        if (last == NULL) {
+            list->head = newNode;
+        } else {
+            last->next = newNode;
         }
-        temp->next = newNode;
-        newNode->next = list->head;
+        last = newNode;
+        list->length++;
+    }
+    if (last != NULL) {
+        last->next = list->head;
+        list->tail = last;
     }
 }
 
@@ -40,10 +79,19 @@ void display(struct CircularLinkedList* list) {
 }
 
 int main() {
-    struct CircularLinkedList list = {NULL};
+    struct CircularLinkedList list;
+    initList(&list);
     insert(&list, 1);
     insert(&list, 2);
     insert(&list, 3);
     display(&list);
+    list_destroy(&list);
+
+    int values[] = {4, 5, 6};
+    initList(&list);
+    list_from_array(&list, values, 3);
+    insert(&list, 7);
+    display(&list);
+    list_destroy(&list);
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
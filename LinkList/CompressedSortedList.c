@@ -0,0 +1,476 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#include "NodePool.h"
+
+// Compressed sequence of sorted unsigned ints.
+//
+// A struct Node spends 16 bytes (4 of data, 4 of padding, 8 of next pointer)
+// per element. Sorted ids with small gaps need far less: the list stores the
+// difference to the previous value instead of the value, and writes each
+// difference in group-varint form. Four differences share one tag byte that
+// holds their lengths (2 bits each, 1 to 4 bytes), followed by the bytes
+// themselves, little end first. A gap below 256 costs 1.25 bytes.
+//
+// Values arrive through compressedAppend in non-decreasing order and are
+// packed in blocks of BLOCK_SIZE. A skip index keeps every block's first
+// value and byte offset, so compressedSearch binary-searches the index and
+// decodes a single block. The newest, not yet full block stays uncompressed
+// in `tail` until it fills up.
+//
+// Decoding a group needs no branches: read 4 bytes unaligned and mask off
+// what belongs to the next value. Built with SSSE3 (-mssse3 or
+// -march=native), one pshufb spreads a whole group into four 32-bit lanes.
+// Both decoders read up to 16 bytes past the last group, so the byte buffer
+// keeps DECODE_SLACK spare bytes at the end. Little-endian targets only.
+
+#define BLOCK_SIZE 128     // Values per compressed block, a multiple of 4
+#define DECODE_SLACK 16    // Bytes readable past the end of the encoded data
+#define MAX_GROUP_BYTES 17 // Tag byte + 4 values of 4 bytes
+
+// Where a compressed block starts
+struct SkipEntry {
+    uint32_t first;     // First value of the block
+    uint32_t offset;    // Byte offset of the block's groups in bytes
+};
+
+struct CompressedList {
+    uint8_t* bytes;             // Encoded blocks back to back
+    size_t used;
+    size_t capacity;            // Not counting DECODE_SLACK
+    struct SkipEntry* index;    // One entry per compressed block
+    int blocks;
+    int indexCapacity;
+    uint32_t tail[BLOCK_SIZE];  // Values not compressed yet
+    int tailCount;
+    uint32_t last;              // Most recently appended value
+    size_t count;               // All values, compressed and not
+};
+
+void compressedInit(struct CompressedList* list) {
+    list->bytes = NULL;
+    list->used = 0;
+    list->capacity = 0;
+    list->index = NULL;
+    list->blocks = 0;
+    list->indexCapacity = 0;
+    list->tailCount = 0;
+    list->last = 0;
+    list->count = 0;
+}
+
+void compressedDestroy(struct CompressedList* list) {
+    free(list->bytes);
+    free(list->index);
+    compressedInit(list);
+}
+
+// Bytes held by the list, including unused capacity
+size_t compressedMemory(const struct CompressedList* list) {
+    return sizeof(*list) + (list->bytes != NULL ? list->capacity + DECODE_SLACK : 0) +
+           (size_t)list->indexCapacity * sizeof(struct SkipEntry);
+}
+
+// ---------------------------------------------------------------------------
+// Group varint
+// ---------------------------------------------------------------------------
+
+static inline int bytesNeeded(uint32_t v) {
+    return v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4;
+}
+
+// Write four values after one tag byte; returns the end of the group
+static uint8_t* encodeGroup(uint8_t* out, const uint32_t* values) {
+    uint8_t* tag = out++;
+    uint8_t lengths = 0;
+    for (int k = 0; k < 4; k++) {
+        int length = bytesNeeded(values[k]);
+        for (int b = 0; b < length; b++) *out++ = (uint8_t)(values[k] >> (8 * b));
+        lengths |= (uint8_t)((length - 1) << (2 * k));
+    }
+    *tag = lengths;
+    return out;
+}
+
+#ifndef __SSSE3__
+static const uint32_t lengthMask[4] = {0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+// Decode BLOCK_SIZE differences starting at in and add them up from `first`
+static void decodeBlockScalar(const uint8_t* in, uint32_t first, uint32_t* out) {
+    uint32_t value = first;
+    for (int i = 0; i < BLOCK_SIZE; i += 4) {
+        uint8_t tag = *in++;
+        for (int k = 0; k < 4; k++) {
+            int length = (tag >> (2 * k)) & 3;
+            uint32_t word;
+            memcpy(&word, in, sizeof(word));
+            value += word & lengthMask[length];
+            out[i + k] = value;
+            in += length + 1;
+        }
+    }
+}
+#else
+// For each tag: the pshufb control that moves each value's bytes into its
+// own 32-bit lane (0x80 clears a byte), and the number of data bytes. The
+// macros spell out all 256 rows so the tables are constant data.
+#define GV_LENGTH(tag, k) ((((tag) >> (2 * (k))) & 3) + 1)
+#define GV_OFFSET(tag, k) (((k) > 0 ? GV_LENGTH(tag, 0) : 0) + ((k) > 1 ? GV_LENGTH(tag, 1) : 0) + \
+                           ((k) > 2 ? GV_LENGTH(tag, 2) : 0))
+#define GV_BYTE(tag, k, b) ((b) < GV_LENGTH(tag, k) ? GV_OFFSET(tag, k) + (b) : 0x80)
+#define GV_LANE(tag, k) GV_BYTE(tag, k, 0), GV_BYTE(tag, k, 1), GV_BYTE(tag, k, 2), GV_BYTE(tag, k, 3)
+#define GV_SHUFFLE(tag) {GV_LANE(tag, 0), GV_LANE(tag, 1), GV_LANE(tag, 2), GV_LANE(tag, 3)}
+#define GV_TOTAL(tag) (GV_OFFSET(tag, 3) + GV_LENGTH(tag, 3))
+#define GV_ROWS4(row, tag) row(tag), row((tag) + 1), row((tag) + 2), row((tag) + 3)
+#define GV_ROWS16(row, tag) GV_ROWS4(row, tag), GV_ROWS4(row, (tag) + 4), GV_ROWS4(row, (tag) + 8), \
+                            GV_ROWS4(row, (tag) + 12)
+#define GV_ROWS64(row, tag) GV_ROWS16(row, tag), GV_ROWS16(row, (tag) + 16), GV_ROWS16(row, (tag) + 32), \
+                            GV_ROWS16(row, (tag) + 48)
+#define GV_ROWS256(row) GV_ROWS64(row, 0), GV_ROWS64(row, 64), GV_ROWS64(row, 128), GV_ROWS64(row, 192)
+
+static const uint8_t shuffleTable[256][16] = {GV_ROWS256(GV_SHUFFLE)};
+static const uint8_t groupLength[256] = {GV_ROWS256(GV_TOTAL)};
+
+static void decodeBlockSimd(const uint8_t* in, uint32_t first, uint32_t* out) {
+    __m128i previous = _mm_set1_epi32((int)first);
+    for (int i = 0; i < BLOCK_SIZE; i += 4) {
+        uint8_t tag = *in++;
+        __m128i data = _mm_loadu_si128((const __m128i*)in);
+        __m128i deltas = _mm_shuffle_epi8(data, _mm_loadu_si128((const __m128i*)shuffleTable[tag]));
+        // Prefix sum of the four lanes, plus the last value of the previous group
+        deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 4));
+        deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 8));
+        __m128i values = _mm_add_epi32(deltas, previous);
+        _mm_storeu_si128((__m128i*)(out + i), values);
+        previous = _mm_shuffle_epi32(values, 0xFF);
+        in += groupLength[tag];
+    }
+}
+#endif
+
+static void decodeBlock(const struct CompressedList* list, int block, uint32_t* out) {
+#ifdef __SSSE3__
+    decodeBlockSimd(list->bytes + list->index[block].offset, list->index[block].first, out);
+#else
+    decodeBlockScalar(list->bytes + list->index[block].offset, list->index[block].first, out);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Building
+// ---------------------------------------------------------------------------
+
+// Compress the full tail into a new block
+static int flushTail(struct CompressedList* list) {
+    size_t worst = (BLOCK_SIZE / 4) * MAX_GROUP_BYTES;
+    if (list->used + worst > UINT32_MAX) return -1;
+    if (list->used + worst > list->capacity) {
+        size_t capacity = list->capacity > 0 ? list->capacity : 4096;
+        while (capacity < list->used + worst) capacity *= 2;
+        uint8_t* bytes = (uint8_t*)realloc(list->bytes, capacity + DECODE_SLACK);
+        if (bytes == NULL) return -1;
+        memset(bytes + capacity, 0, DECODE_SLACK);
+        list->bytes = bytes;
+        list->capacity = capacity;
+    }
+    if (list->blocks == list->indexCapacity) {
+        int capacity = list->indexCapacity > 0 ? list->indexCapacity * 2 : 64;
+        struct SkipEntry* index = (struct SkipEntry*)realloc(list->index, (size_t)capacity * sizeof(struct SkipEntry));
+        if (index == NULL) return -1;
+        list->index = index;
+        list->indexCapacity = capacity;
+    }
+    uint32_t deltas[BLOCK_SIZE];
+    uint32_t previous = list->tail[0];
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        deltas[i] = list->tail[i] - previous;   // deltas[0] is always 0
+        previous = list->tail[i];
+    }
+    list->index[list->blocks].first = list->tail[0];
+    list->index[list->blocks].offset = (uint32_t)list->used;
+    uint8_t* out = list->bytes + list->used;
+    for (int i = 0; i < BLOCK_SIZE; i += 4) out = encodeGroup(out, deltas + i);
+    list->used = (size_t)(out - list->bytes);
+    list->blocks++;
+    list->tailCount = 0;
+    return 0;
+}
+
+// Append a value no smaller than the last one. Returns 0, or -1 if the
+// value is out of order or memory ran out.
+int compressedAppend(struct CompressedList* list, uint32_t value) {
+    if (list->count > 0 && value < list->last) return -1;
+    list->tail[list->tailCount++] = value;
+    if (list->tailCount == BLOCK_SIZE && flushTail(list) != 0) {
+        list->tailCount--;
+        return -1;
+    }
+    list->last = value;
+    list->count++;
+    return 0;
+}
+
+// Build from a sorted array (appended to whatever the list holds)
+int compressedFromArray(struct CompressedList* list, const uint32_t* values, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (compressedAppend(list, values[i]) != 0) return -1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Reading
+// ---------------------------------------------------------------------------
+
+// Value at position i (0 <= i < count): decodes one block
+uint32_t compressedGet(const struct CompressedList* list, size_t i) {
+    size_t block = i / BLOCK_SIZE;
+    if (block == (size_t)list->blocks) return list->tail[i % BLOCK_SIZE];
+    uint32_t values[BLOCK_SIZE];
+    decodeBlock(list, (int)block, values);
+    return values[i % BLOCK_SIZE];
+}
+
+// Position of the first value >= key, or count if there is none.
+// Binary search over the skip index, then over one decoded block.
+size_t compressedLowerBound(const struct CompressedList* list, uint32_t key) {
+    // Last block whose first value is below key; key can only be there or
+    // at the start of the next block
+    int lo = 0, hi = list->blocks;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (list->index[mid].first < key) lo = mid + 1;
+        else hi = mid;
+    }
+    int block = lo - 1;
+    const uint32_t* values = list->tail;
+    int count = list->tailCount;
+    uint32_t decoded[BLOCK_SIZE];
+    if (block < 0) {
+        if (list->blocks > 0) return 0;   // key <= the very first value
+        block = 0;                        // Only the tail holds values
+    } else {
+        decodeBlock(list, block, decoded);
+        values = decoded;
+        count = BLOCK_SIZE;
+        if (decoded[BLOCK_SIZE - 1] < key) {
+            // Not in this block: the answer is the start of the next one,
+            // or somewhere in the tail after the last block
+            if (block + 1 < list->blocks) return (size_t)(block + 1) * BLOCK_SIZE;
+            values = list->tail;
+            count = list->tailCount;
+            block = list->blocks;
+        }
+    }
+    int first = 0, last = count;
+    while (first < last) {
+        int mid = (first + last) / 2;
+        if (values[mid] < key) first = mid + 1;
+        else last = mid;
+    }
+    return (size_t)block * BLOCK_SIZE + (size_t)first;
+}
+
+// Returns 1 if key is in the list
+int compressedSearch(const struct CompressedList* list, uint32_t key) {
+    size_t i = compressedLowerBound(list, key);
+    return i < list->count && compressedGet(list, i) == key;
+}
+
+// Decode everything into out (room for count values)
+void compressedDecodeAll(const struct CompressedList* list, uint32_t* out) {
+    for (int b = 0; b < list->blocks; b++) decodeBlock(list, b, out + (size_t)b * BLOCK_SIZE);
+    memcpy(out + (size_t)list->blocks * BLOCK_SIZE, list->tail, (size_t)list->tailCount * sizeof(uint32_t));
+}
+
+// Sum of all values, decoding one block at a time through a small buffer
+uint64_t compressedSum(const struct CompressedList* list) {
+    uint32_t values[BLOCK_SIZE];
+    uint64_t sum = 0;
+    for (int b = 0; b < list->blocks; b++) {
+        decodeBlock(list, b, values);
+        for (int i = 0; i < BLOCK_SIZE; i++) sum += values[i];
+    }
+    for (int i = 0; i < list->tailCount; i++) sum += list->tail[i];
+    return sum;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: bytes per element and scan / search speed against a singly
+// linked list of ints (nodes from NodePool, as in the other list programs)
+// and a plain uint32_t array
+// ---------------------------------------------------------------------------
+
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Sorted ids: mostly gaps below 16, one in 64 up to 4096, one in 4096 up to 1M
+static void makeIds(uint32_t* ids, size_t n, uint64_t seed) {
+    uint32_t value = 1000;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t r = nextRandom(&seed);
+        uint32_t gap = (r & 63) != 0 ? (uint32_t)(r >> 8) % 16
+                     : (r & 0xFC0) != 0 ? (uint32_t)(r >> 16) % 4096
+                     : (uint32_t)(r >> 32) % (1u << 20);
+        value += gap;
+        ids[i] = value;
+    }
+}
+
+static void runBenchmark(size_t n, int lookups) {
+    uint32_t* ids = (uint32_t*)malloc(n * sizeof(uint32_t));
+    uint32_t* decoded = (uint32_t*)malloc(n * sizeof(uint32_t));
+    uint32_t* probes = (uint32_t*)malloc((size_t)lookups * sizeof(uint32_t));
+    if (ids == NULL || decoded == NULL || probes == NULL) {
+        free(ids);
+        free(decoded);
+        free(probes);
+        return;
+    }
+    makeIds(ids, n, 0x9E3779B97F4A7C15ULL);
+    uint64_t seed = 12345;
+    for (int i = 0; i < lookups; i++) {
+        // Half hits, half (probable) misses
+        uint32_t v = ids[nextRandom(&seed) % n];
+        probes[i] = (i & 1) ? v + 1 : v;
+    }
+
+    struct NodePool pool;
+    poolInit(&pool, sizeof(struct Node), POOL_DEFAULT_SLAB_NODES);
+    struct Node* head = NULL;
+    struct Node** link = &head;
+    for (size_t i = 0; i < n; i++) {
+        struct Node* node = (struct Node*)poolAlloc(&pool);
+        node->data = (int)ids[i];
+        node->next = NULL;
+        *link = node;
+        link = &node->next;
+    }
+
+    struct CompressedList list;
+    compressedInit(&list);
+    double t0 = nowSeconds();
+    compressedFromArray(&list, ids, n);
+    double build = nowSeconds() - t0;
+
+    printf("%zu sorted ids, %s block decoder\n", n,
+#ifdef __SSSE3__
+           "SSSE3"
+#else
+           "scalar"
+#endif
+    );
+    printf("bytes per element: linked list %.2f, array %.2f, compressed %.2f (build %.1f ns/element)\n",
+           (double)sizeof(struct Node), (double)sizeof(uint32_t), (double)compressedMemory(&list) / n,
+           build * 1e9 / n);
+
+    // Full scans, best of 5
+    double best[3] = {1e30, 1e30, 1e30};
+    uint64_t sums[3] = {0, 0, 0};
+    for (int rep = 0; rep < 5; rep++) {
+        t0 = nowSeconds();
+        uint64_t sum = 0;
+        for (struct Node* node = head; node != NULL; node = node->next) sum += (uint32_t)node->data;
+        double t = nowSeconds() - t0;
+        if (t < best[0]) best[0] = t;
+        sums[0] = sum;
+
+        t0 = nowSeconds();
+        sum = 0;
+        for (size_t i = 0; i < n; i++) sum += ids[i];
+        t = nowSeconds() - t0;
+        if (t < best[1]) best[1] = t;
+        sums[1] = sum;
+
+        t0 = nowSeconds();
+        sums[2] = compressedSum(&list);
+        t = nowSeconds() - t0;
+        if (t < best[2]) best[2] = t;
+    }
+    printf("scan (M elements/s):    linked list %8.1f, array %8.1f, compressed %8.1f%s\n", n / best[0] / 1e6,
+           n / best[1] / 1e6, n / best[2] / 1e6, sums[0] == sums[2] && sums[1] == sums[2] ? "" : "  (sums differ)");
+
+    memset(decoded, 0, n * sizeof(uint32_t));   // Fault the pages in before timing
+    t0 = nowSeconds();
+    compressedDecodeAll(&list, decoded);
+    double decodeAll = nowSeconds() - t0;
+    printf("decode into an array:   %.1f M elements/s%s\n", n / decodeAll / 1e6,
+           memcmp(decoded, ids, n * sizeof(uint32_t)) == 0 ? "" : "  (mismatch)");
+
+    // Lookups: the linked list has to walk from the head every time
+    int listLookups = lookups < 200 ? lookups : 200;
+    int hits[3] = {0, 0, 0};
+    t0 = nowSeconds();
+    for (int i = 0; i < listLookups; i++) {
+        struct Node* node = head;
+        while (node != NULL && (uint32_t)node->data < probes[i]) node = node->next;
+        hits[0] += node != NULL && (uint32_t)node->data == probes[i];
+    }
+    double listTime = (nowSeconds() - t0) / listLookups;
+    t0 = nowSeconds();
+    for (int i = 0; i < lookups; i++) {
+        size_t lo = 0, hi = n;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (ids[mid] < probes[i]) lo = mid + 1;
+            else hi = mid;
+        }
+        hits[1] += lo < n && ids[lo] == probes[i];
+    }
+    double arrayTime = (nowSeconds() - t0) / lookups;
+    t0 = nowSeconds();
+    for (int i = 0; i < lookups; i++) hits[2] += compressedSearch(&list, probes[i]);
+    double compressedTime = (nowSeconds() - t0) / lookups;
+    printf("search (ns per lookup): linked list %8.0f, array %8.0f, compressed %8.0f (hits %d/%d, %d/%d, %d/%d)\n",
+           listTime * 1e9, arrayTime * 1e9, compressedTime * 1e9, hits[0], listLookups, hits[1], lookups, hits[2],
+           lookups);
+
+    compressedDestroy(&list);
+    poolDestroy(&pool);
+    free(ids);
+    free(decoded);
+    free(probes);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [elements] [lookups]
+        long n = argc > 2 ? atol(argv[2]) : 4000000;
+        int lookups = argc > 3 ? atoi(argv[3]) : 1000000;
+        if (n < 1) n = 1;
+        if (lookups < 1) lookups = 1;
+        runBenchmark((size_t)n, lookups);
+        return 0;
+    }
+
+    struct CompressedList list;
+    compressedInit(&list);
+    for (uint32_t i = 0; i < 1000; i++) compressedAppend(&list, 100000 + i * 3 + (i % 7 == 0));
+    printf("Out of order append: %d\n", compressedAppend(&list, 5));   // -1
+    printf("%zu values in %zu bytes\n", list.count, list.used + list.tailCount * sizeof(uint32_t));   // 1000 values in 1536 bytes
+    printf("Value at 500: %u\n", compressedGet(&list, 500));   // 101500
+    printf("Contains 101500: %d, 101501: %d\n", compressedSearch(&list, 101500), compressedSearch(&list, 101501));   // 1, 0
+    printf("First value >= 102000 is at %zu\n", compressedLowerBound(&list, 102000));   // 667
+    compressedDestroy(&list);
+    return 0;
+}
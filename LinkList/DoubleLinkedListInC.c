@@ -1,5 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>    // pow() in the Zipf generator: link with -lm
+#include <time.h>
+#include <pthread.h>
+#include "NodePool.h"
 
 // Node structure for doubly linked list
 struct Node {
@@ -8,9 +14,28 @@ struct Node {
     struct Node* next; // Pointer to the next node
 };
 
+// The list owns the pool its nodes are allocated from
+struct DoublyLinkedList {
+    struct Node* head;
+    struct NodePool pool;
+};
+
+// Initialize an empty list
+void initList(struct DoublyLinkedList* list) {
+    list->head = NULL;
+    poolInit(&list->pool, sizeof(struct Node), POOL_DEFAULT_SLAB_NODES);
+}
+
+// Free every node of the list at once by releasing the pool's slabs
+void list_destroy(struct DoublyLinkedList* list) {
+    poolDestroy(&list->pool);
+    list->head = NULL;
+}
+
 // Function to create a new node
-struct Node* createNode(int data) {
-    struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
+struct Node* createNode(struct DoublyLinkedList* list, int data) {
+    struct Node* newNode = (struct Node*)poolAlloc(&list->pool);
+    if (newNode == NULL) return NULL;
     newNode->data = data;
     newNode->prev = NULL;
     newNode->next = NULL;
@@ -18,14 +43,15 @@ struct Node* createNode(int data) {
 }
 
 // Function to insert a node at the front of the list
-void insertFront(struct Node** head, int data) {
-    struct Node* newNode = createNode(data);
-    newNode->next = *head;
+void insertFront(struct DoublyLinkedList* list, int data) {
+    struct Node* newNode = createNode(list, data);
+    if (newNode == NULL) return;
+    newNode->next = list->head;
 
-    if (*head != NULL)
-        (*head)->prev = newNode;
+    if (list->head != NULL)
+        list->head->prev = newNode;
 
-    *head = newNode;
+    list->head = newNode;
 }
 
 // Function to print the list forward
@@ -45,17 +71,422 @@ void printList(struct Node* node) {
     }
 }
 
+// ---------------------------------------------------------------------------
+// LRU cache: a doubly linked list in recency order plus a hash table from key
+// to node. get moves the node to the front, put inserts there, and when the
+// cache is full the node at the back is evicted and reused. All O(1).
+// ---------------------------------------------------------------------------
+
+struct LRUNode {
+    int key;
+    int value;
+    struct LRUNode* prev;
+    struct LRUNode* next;
+};
+
+// Open-addressing slot: the key is kept next to the node number so probing
+// does not touch the nodes. node is 1 + the index into the node array, 0
+// for an empty slot.
+struct LRUSlot {
+    int key;
+    int node;
+};
+
+struct LRUStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+};
+
+// Fixed capacity; every node comes from one array allocated up front. The
+// list is circular around a sentinel, so linking and unlinking never check
+// for NULL: sentinel.next is the most recently used node, sentinel.prev the
+// least.
+struct LRUCache {
+    struct LRUNode sentinel;
+    struct LRUNode* nodes;
+    int capacity;
+    int used;                 // Nodes handed out so far
+    struct LRUSlot* slots;
+    size_t slotMask;          // Slot count - 1; kept at most half full
+    struct LRUStats stats;
+};
+
+static inline uint64_t lruHash(int key) {
+    return (uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ULL;
+}
+
+static inline size_t lruSlotIndex(uint64_t h, size_t mask) {
+    return (size_t)(h ^ h >> 32) & mask;
+}
+
+static inline void lruUnlink(struct LRUNode* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+}
+
+static inline void lruPushFront(struct LRUCache* cache, struct LRUNode* node) {
+    node->prev = &cache->sentinel;
+    node->next = cache->sentinel.next;
+    cache->sentinel.next->prev = node;
+    cache->sentinel.next = node;
+}
+
+// Returns 0, or -1 if out of memory
+int lruInit(struct LRUCache* cache, int capacity) {
+    if (capacity < 1) capacity = 1;
+    size_t slotCount = 16;
+    while (slotCount < (size_t)capacity * 2) slotCount *= 2;
+    cache->nodes = (struct LRUNode*)malloc((size_t)capacity * sizeof(struct LRUNode));
+    cache->slots = (struct LRUSlot*)calloc(slotCount, sizeof(struct LRUSlot));
+    if (cache->nodes == NULL || cache->slots == NULL) {
+        free(cache->nodes);
+        free(cache->slots);
+        return -1;
+    }
+    cache->sentinel.prev = cache->sentinel.next = &cache->sentinel;
+    cache->capacity = capacity;
+    cache->used = 0;
+    cache->slotMask = slotCount - 1;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    return 0;
+}
+
+void lruDestroy(struct LRUCache* cache) {
+    free(cache->nodes);
+    free(cache->slots);
+    cache->nodes = NULL;
+    cache->slots = NULL;
+}
+
+// Slot holding key, or the empty slot where it would go
+static inline struct LRUSlot* lruFindSlot(struct LRUCache* cache, int key) {
+    size_t i = lruSlotIndex(lruHash(key), cache->slotMask);
+    while (cache->slots[i].node != 0 && cache->slots[i].key != key) {
+        i = (i + 1) & cache->slotMask;
+    }
+    return &cache->slots[i];
+}
+
+// Empty a slot, shifting later entries of the probe run back into the hole
+static void lruRemoveSlot(struct LRUCache* cache, struct LRUSlot* slot) {
+    size_t mask = cache->slotMask;
+    size_t hole = (size_t)(slot - cache->slots);
+    for (size_t i = (hole + 1) & mask; cache->slots[i].node != 0; i = (i + 1) & mask) {
+        size_t home = lruSlotIndex(lruHash(cache->slots[i].key), mask);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            cache->slots[hole] = cache->slots[i];
+            hole = i;
+        }
+    }
+    cache->slots[hole].node = 0;
+}
+
+// Look up key and mark it most recently used. Returns 1 and stores the value
+// on a hit, 0 on a miss.
+int lruGet(struct LRUCache* cache, int key, int* value) {
+    struct LRUSlot* slot = lruFindSlot(cache, key);
+    if (slot->node == 0) {
+        cache->stats.misses++;
+        return 0;
+    }
+    struct LRUNode* node = &cache->nodes[slot->node - 1];
+    if (cache->sentinel.next != node) {
+        lruUnlink(node);
+        lruPushFront(cache, node);
+    }
+    cache->stats.hits++;
+    *value = node->value;
+    return 1;
+}
+
+// Insert or update key as the most recently used entry. Returns 1 if the
+// least recently used entry was evicted to make room, 0 otherwise.
+int lruPut(struct LRUCache* cache, int key, int value) {
+    struct LRUSlot* slot = lruFindSlot(cache, key);
+    if (slot->node != 0) {
+        struct LRUNode* node = &cache->nodes[slot->node - 1];
+        node->value = value;
+        lruUnlink(node);
+        lruPushFront(cache, node);
+        return 0;
+    }
+
+    struct LRUNode* node;
+    int evicted = 0;
+    if (cache->used < cache->capacity) {
+        node = &cache->nodes[cache->used++];
+    } else {
+        // Reuse the least recently used node
+        node = cache->sentinel.prev;
+        lruUnlink(node);
+        lruRemoveSlot(cache, lruFindSlot(cache, node->key));
+        slot = lruFindSlot(cache, key);  // The removal may have shifted slots
+        cache->stats.evictions++;
+        evicted = 1;
+    }
+    node->key = key;
+    node->value = value;
+    lruPushFront(cache, node);
+    slot->key = key;
+    slot->node = (int)(node - cache->nodes) + 1;
+    return evicted;
+}
+
+// ---------------------------------------------------------------------------
+// Sharded LRU for concurrent use: keys are split over independent caches,
+// each behind its own lock, so threads touching different shards do not
+// contend. Recency is tracked per shard, which approximates a global LRU.
+// ---------------------------------------------------------------------------
+
+struct LRUShard {
+    pthread_mutex_t lock;
+    struct LRUCache cache;
+} __attribute__((aligned(64)));  // Neighbouring shards never share a cache line
+
+struct ShardedLRU {
+    struct LRUShard* shards;
+    int shardCount;
+};
+
+// capacity is split evenly over the shards. Returns 0, or -1 if out of memory.
+int shardedInit(struct ShardedLRU* lru, int capacity, int shardCount) {
+    if (shardCount < 1) shardCount = 1;
+    lru->shards = (struct LRUShard*)aligned_alloc(64, (size_t)shardCount * sizeof(struct LRUShard));
+    if (lru->shards == NULL) return -1;
+    for (int i = 0; i < shardCount; i++) {
+        if (lruInit(&lru->shards[i].cache, (capacity + shardCount - 1) / shardCount) != 0) {
+            while (i-- > 0) {
+                lruDestroy(&lru->shards[i].cache);
+                pthread_mutex_destroy(&lru->shards[i].lock);
+            }
+            free(lru->shards);
+            return -1;
+        }
+        pthread_mutex_init(&lru->shards[i].lock, NULL);
+    }
+    lru->shardCount = shardCount;
+    return 0;
+}
+
+void shardedDestroy(struct ShardedLRU* lru) {
+    for (int i = 0; i < lru->shardCount; i++) {
+        lruDestroy(&lru->shards[i].cache);
+        pthread_mutex_destroy(&lru->shards[i].lock);
+    }
+    free(lru->shards);
+    lru->shards = NULL;
+}
+
+// The top bits of the hash pick the shard; the slot index uses the rest
+static inline struct LRUShard* shardFor(struct ShardedLRU* lru, int key) {
+    uint64_t h = lruHash(key);
+    return &lru->shards[((h >> 32) * (uint64_t)lru->shardCount) >> 32];
+}
+
+int shardedGet(struct ShardedLRU* lru, int key, int* value) {
+    struct LRUShard* shard = shardFor(lru, key);
+    pthread_mutex_lock(&shard->lock);
+    int hit = lruGet(&shard->cache, key, value);
+    pthread_mutex_unlock(&shard->lock);
+    return hit;
+}
+
+int shardedPut(struct ShardedLRU* lru, int key, int value) {
+    struct LRUShard* shard = shardFor(lru, key);
+    pthread_mutex_lock(&shard->lock);
+    int evicted = lruPut(&shard->cache, key, value);
+    pthread_mutex_unlock(&shard->lock);
+    return evicted;
+}
+
+// Counters summed over all shards
+void shardedStats(struct ShardedLRU* lru, struct LRUStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < lru->shardCount; i++) {
+        pthread_mutex_lock(&lru->shards[i].lock);
+        stats->hits += lru->shards[i].cache.stats.hits;
+        stats->misses += lru->shards[i].cache.stats.misses;
+        stats->evictions += lru->shards[i].cache.stats.evictions;
+        pthread_mutex_unlock(&lru->shards[i].lock);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks: Zipfian key traces against the plain cache, and threads against
+// one locked cache versus the sharded one
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Zipfian ranks 0..n-1 with skew theta < 1 (Gray et al., "Quickly generating
+// billion-record synthetic databases"), the generator YCSB uses
+struct Zipf {
+    int n;
+    double theta, alpha, zetan, eta;
+};
+
+static void zipfInit(struct Zipf* z, int n, double theta) {
+    double zeta2 = 1.0 + pow(0.5, theta);
+    z->n = n;
+    z->theta = theta;
+    z->zetan = 0;
+    for (int i = 1; i <= n; i++) z->zetan += 1.0 / pow((double)i, theta);
+    z->alpha = 1.0 / (1.0 - theta);
+    z->eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / z->zetan);
+}
+
+static int zipfNext(struct Zipf* z, uint64_t* seed) {
+    double u = (nextRandom(seed) >> 11) * (1.0 / 9007199254740992.0);
+    double uz = u * z->zetan;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + pow(0.5, z->theta)) return 1;
+    int rank = (int)(z->n * pow(z->eta * u - z->eta + 1.0, z->alpha));
+    return rank < z->n ? rank : z->n - 1;
+}
+
+// Fill trace with keys; ranks are scattered so popular keys are not neighbours
+static void makeTrace(int* trace, int count, struct Zipf* z, uint64_t seed) {
+    for (int i = 0; i < count; i++) {
+        trace[i] = (int)((uint32_t)zipfNext(z, &seed) * 2654435761u);
+    }
+}
+
+// Read-through use: get, and put on a miss
+static void replay(struct LRUCache* cache, const int* trace, int count) {
+    for (int i = 0; i < count; i++) {
+        int value;
+        if (!lruGet(cache, trace[i], &value)) lruPut(cache, trace[i], trace[i]);
+    }
+}
+
+struct ReplayJob {
+    struct ShardedLRU* lru;
+    const int* trace;
+    int count;
+};
+
+static void* replaySharded(void* arg) {
+    struct ReplayJob* job = (struct ReplayJob*)arg;
+    for (int i = 0; i < job->count; i++) {
+        int value;
+        if (!shardedGet(job->lru, job->trace[i], &value)) shardedPut(job->lru, job->trace[i], job->trace[i]);
+    }
+    return NULL;
+}
+
+#define MAX_THREADS 64
+
+static void runBenchmark(int universe, int traceLength, int threads) {
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    double skews[] = {0.5, 0.9, 0.99};
+    int* trace = (int*)malloc((size_t)traceLength * sizeof(int));
+    struct Zipf z;
+
+    printf("%d keys, %d requests per run\n", universe, traceLength);
+    printf("%6s %10s %10s %12s %12s\n", "skew", "capacity", "hit rate", "evictions", "Mops/s");
+    for (int s = 0; s < 3; s++) {
+        zipfInit(&z, universe, skews[s]);
+        makeTrace(trace, traceLength, &z, 42 + s);
+        for (int fraction = 100; fraction >= 10; fraction /= 10) {
+            struct LRUCache cache;
+            int capacity = universe / fraction;
+            if (lruInit(&cache, capacity) != 0) continue;
+            double t0 = nowSeconds();
+            replay(&cache, trace, traceLength);
+            double elapsed = nowSeconds() - t0;
+            printf("%6.2f %10d %9.1f%% %12llu %12.1f\n", skews[s], capacity,
+                   100.0 * cache.stats.hits / traceLength, (unsigned long long)cache.stats.evictions,
+                   traceLength / elapsed / 1e6);
+            lruDestroy(&cache);
+        }
+    }
+
+    // Concurrent replay: every thread has its own trace over the same keys
+    zipfInit(&z, universe, 0.99);
+    int perThread = traceLength / threads;
+    struct ReplayJob jobs[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    int started[MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        makeTrace(trace + (size_t)t * perThread, perThread, &z, 1000 + t);
+    }
+    printf("\n%d threads, skew 0.99, capacity %d\n", threads, universe / 10);
+    printf("%8s %10s %12s\n", "shards", "hit rate", "Mops/s");
+    int shardCounts[] = {1, 4, 16, 64};
+    for (int s = 0; s < 4; s++) {
+        struct ShardedLRU lru;
+        if (shardedInit(&lru, universe / 10, shardCounts[s]) != 0) continue;
+        double t0 = nowSeconds();
+        for (int t = 0; t < threads; t++) {
+            jobs[t].lru = &lru;
+            jobs[t].trace = trace + (size_t)t * perThread;
+            jobs[t].count = perThread;
+            started[t] = pthread_create(&ids[t], NULL, replaySharded, &jobs[t]) == 0;
+            if (!started[t]) replaySharded(&jobs[t]);
+        }
+        for (int t = 0; t < threads; t++) {
+            if (started[t]) pthread_join(ids[t], NULL);
+        }
+        double elapsed = nowSeconds() - t0;
+        struct LRUStats stats;
+        shardedStats(&lru, &stats);
+        printf("%8d %9.1f%% %12.1f\n", shardCounts[s], 100.0 * stats.hits / ((double)perThread * threads),
+               (double)perThread * threads / elapsed / 1e6);
+        shardedDestroy(&lru);
+    }
+    free(trace);
+}
+
 // Main function to test the doubly linked list
-int main() {
-    struct Node* head = NULL;
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [keys] [requests] [threads]
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 1000000,
+                     argc > 3 ? atoi(argv[3]) : 10000000,
+                     argc > 4 ? atoi(argv[4]) : 4);
+        return 0;
+    }
+
+    struct DoublyLinkedList list;
+    initList(&list);
 
     // Insert nodes into the list
-    insertFront(&head, 10);
-    insertFront(&head, 20);
-    insertFront(&head, 30);
+    insertFront(&list, 10);
+    insertFront(&list, 20);
+    insertFront(&list, 30);
 
     // Print the list
-    printList(head);
+    printList(list.head);
+
+    // Free all nodes at once
+    list_destroy(&list);
+
+    // An LRU cache of three entries
+    struct LRUCache cache;
+    int value;
+    lruInit(&cache, 3);
+    lruPut(&cache, 1, 100);
+    lruPut(&cache, 2, 200);
+    lruPut(&cache, 3, 300);
+    lruGet(&cache, 1, &value);   // 1 is now the most recently used
+    lruPut(&cache, 4, 400);      // Evicts 2
+    printf("\n\nLRU cache: 2 is %s, 1 = %d\n", lruGet(&cache, 2, &value) ? "cached" : "evicted",
+           lruGet(&cache, 1, &value) ? value : -1);
+    printf("hits %llu, misses %llu, evictions %llu\n", (unsigned long long)cache.stats.hits,
+           (unsigned long long)cache.stats.misses, (unsigned long long)cache.stats.evictions);
+    lruDestroy(&cache);
 
     return 0;
 }
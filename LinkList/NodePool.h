@@ -0,0 +1,188 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-size node allocator shared by the C linked-list programs.
+//
+// Nodes are carved out of large slabs instead of being malloc'd one by one,
+// so neighbouring nodes end up next to each other in memory. Freed nodes go
+// onto an intrusive free list (the free node itself stores the link), and
+// poolDestroy releases whole slabs at once.
+//
+// The plain poolAlloc/poolFree calls are not thread-safe. Compile with
+// -DNODEPOOL_THREADS to get per-thread caches (struct PoolCache) that refill
+// from and drain back into a locked pool in batches.
+
+#ifdef NODEPOOL_THREADS
+#include <pthread.h>
+#endif
+
+#define POOL_DEFAULT_SLAB_NODES 1024  // Nodes per slab
+#define POOL_CACHE_BATCH 64           // Nodes moved between a thread cache and the pool at once
+#define POOL_SLAB_ALIGN 64            // Nodes start on a cache line, so 64-byte nodes never straddle two
+
+// A free node reuses its own memory as the free-list link
+struct FreeNode {
+    struct FreeNode* next;
+};
+
+// Slab header; the nodes follow it in the same allocation
+struct PoolSlab {
+    struct PoolSlab* next;
+};
+
+struct NodePool {
+    size_t nodeSize;
+    size_t slabNodes;
+    struct PoolSlab* slabs;     // Every slab, so they can be freed in bulk
+    struct FreeNode* freeList;  // Nodes returned by poolFree
+    char* bumpNext;             // Never-used space in the newest slab
+    char* bumpEnd;
+#ifdef NODEPOOL_THREADS
+    pthread_mutex_t lock;       // Guards the pool when used through thread caches
+#endif
+};
+
+// Initialize a pool handing out nodes of nodeSize bytes
+static inline void poolInit(struct NodePool* pool, size_t nodeSize, size_t slabNodes) {
+    // Every node must be able to hold a free-list link and stay pointer aligned
+    if (nodeSize < sizeof(struct FreeNode)) nodeSize = sizeof(struct FreeNode);
+    nodeSize = (nodeSize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    pool->nodeSize = nodeSize;
+    pool->slabNodes = slabNodes > 0 ? slabNodes : POOL_DEFAULT_SLAB_NODES;
+    pool->slabs = NULL;
+    pool->freeList = NULL;
+    pool->bumpNext = NULL;
+    pool->bumpEnd = NULL;
+#ifdef NODEPOOL_THREADS
+    pthread_mutex_init(&pool->lock, NULL);
+#endif
+}
+
+// Allocate a new slab and make it the bump region
+static inline int poolGrow(struct NodePool* pool) {
+    struct PoolSlab* slab = (struct PoolSlab*)malloc(sizeof(struct PoolSlab) + POOL_SLAB_ALIGN +
+                                                     pool->nodeSize * pool->slabNodes);
+    if (slab == NULL) return -1;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    // Skip the header and round up to the next cache line
+    uintptr_t start = (uintptr_t)((char*)slab + sizeof(struct PoolSlab));
+    start = (start + POOL_SLAB_ALIGN - 1) & ~(uintptr_t)(POOL_SLAB_ALIGN - 1);
+    pool->bumpNext = (char*)start;
+    pool->bumpEnd = pool->bumpNext + pool->nodeSize * pool->slabNodes;
+    return 0;
+}
+
+// Get one node from the pool, or NULL if memory is exhausted
+static inline void* poolAlloc(struct NodePool* pool) {
+    // Reuse a freed node first, it is most likely still in cache
+    if (pool->freeList != NULL) {
+        struct FreeNode* node = pool->freeList;
+        pool->freeList = node->next;
+        return node;
+    }
+    if (pool->bumpNext == pool->bumpEnd && poolGrow(pool) != 0) {
+        return NULL;
+    }
+    void* node = pool->bumpNext;
+    pool->bumpNext += pool->nodeSize;
+    return node;
+}
+
+// Return one node to the pool
+static inline void poolFree(struct NodePool* pool, void* ptr) {
+    struct FreeNode* node = (struct FreeNode*)ptr;
+    node->next = pool->freeList;
+    pool->freeList = node;
+}
+
+// Release every slab at once. All nodes from this pool become invalid.
+static inline void poolDestroy(struct NodePool* pool) {
+    struct PoolSlab* slab = pool->slabs;
+    while (slab != NULL) {
+        struct PoolSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->freeList = NULL;
+    pool->bumpNext = NULL;
+    pool->bumpEnd = NULL;
+#ifdef NODEPOOL_THREADS
+    pthread_mutex_destroy(&pool->lock);
+#endif
+}
+
+#ifdef NODEPOOL_THREADS
+
+// Per-thread front end to a shared pool. Allocation and free only touch the
+// cache; the pool lock is taken once per POOL_CACHE_BATCH nodes.
+struct PoolCache {
+    struct NodePool* pool;
+    struct FreeNode* list;
+    size_t count;
+};
+
+static inline void poolCacheInit(struct PoolCache* cache, struct NodePool* pool) {
+    cache->pool = pool;
+    cache->list = NULL;
+    cache->count = 0;
+}
+
+static inline void* poolCacheAlloc(struct PoolCache* cache) {
+    if (cache->list == NULL) {
+        // Refill a batch under the lock
+        pthread_mutex_lock(&cache->pool->lock);
+        for (int i = 0; i < POOL_CACHE_BATCH; i++) {
+            struct FreeNode* node = (struct FreeNode*)poolAlloc(cache->pool);
+            if (node == NULL) break;
+            node->next = cache->list;
+            cache->list = node;
+            cache->count++;
+        }
+        pthread_mutex_unlock(&cache->pool->lock);
+        if (cache->list == NULL) return NULL;
+    }
+    struct FreeNode* node = cache->list;
+    cache->list = node->next;
+    cache->count--;
+    return node;
+}
+
+// Give every cached node back to the pool (call before the thread exits)
+static inline void poolCacheFlush(struct PoolCache* cache) {
+    pthread_mutex_lock(&cache->pool->lock);
+    while (cache->list != NULL) {
+        struct FreeNode* node = cache->list;
+        cache->list = node->next;
+        poolFree(cache->pool, node);
+    }
+    cache->count = 0;
+    pthread_mutex_unlock(&cache->pool->lock);
+}
+
+static inline void poolCacheFree(struct PoolCache* cache, void* ptr) {
+    struct FreeNode* node = (struct FreeNode*)ptr;
+    node->next = cache->list;
+    cache->list = node;
+    cache->count++;
+    // Keep the cache bounded so memory freed on one thread can be reused by others
+    if (cache->count >= 2 * POOL_CACHE_BATCH) {
+        pthread_mutex_lock(&cache->pool->lock);
+        for (int i = 0; i < POOL_CACHE_BATCH; i++) {
+            node = cache->list;
+            cache->list = node->next;
+            poolFree(cache->pool, node);
+        }
+        cache->count -= POOL_CACHE_BATCH;
+        pthread_mutex_unlock(&cache->pool->lock);
+    }
+}
+
+#endif  // NODEPOOL_THREADS
+
+#endif  // NODE_POOL_H
@@ -0,0 +1,535 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+// Lock-free skip list (Herlihy and Shavit, "The Art of Multiprocessor
+// Programming", ch. 14) usable as a sorted map and as a priority queue.
+//
+// Every level is a sorted singly linked list. A node is deleted logically by
+// setting the low bit of its own next pointers ("marking" them), top level
+// first; the thread whose CAS marks level 0 owns the deletion. Marked nodes
+// are then unlinked by whichever thread walks past them, so no thread ever
+// waits for another.
+//
+// Memory is reclaimed with epochs. Each thread announces the global epoch it
+// is working in; a removed node goes on the remover's limbo list and is freed
+// once the epoch has advanced twice, by which time no thread can still hold
+// a pointer to it. Threads get a struct SLThread from sl_thread_attach and
+// pass it to every call.
+//
+// An insert links a node bottom-up while it may already be getting deleted,
+// so the node is retired only when both the insert and the delete are done
+// (two bits in `state`); whichever finishes second unlinks any levels the
+// other missed and retires it.
+
+#define MAX_LEVEL 24
+#define CACHE_LINE 64
+#define RETIRE_BATCH 64        // Retired nodes between attempts to advance the epoch
+#define INSERT_DONE 1
+#define DELETE_DONE 2
+
+struct SkipNode {
+    int key;
+    int value;
+    int topLevel;
+    atomic_int state;              // INSERT_DONE | DELETE_DONE
+    struct SkipNode* retiredNext;  // Limbo list link
+    _Atomic(uintptr_t) next[];     // Successor per level; low bit set = this node is deleted
+};
+
+struct SLThread;
+
+struct SkipList {
+    struct SkipNode* head;                 // Sentinel below every key
+    _Alignas(CACHE_LINE) atomic_uint epoch;
+    _Alignas(CACHE_LINE) _Atomic(struct SLThread*) threads;
+};
+
+// Per-thread state: announced epoch, limbo lists, random levels
+struct SLThread {
+    _Alignas(CACHE_LINE) atomic_uint announced;  // epoch * 2 + 1 while inside an operation, 0 outside
+    unsigned epoch;                       // Epoch of the last operation
+    struct SkipNode* limbo[3];            // Retired in epochs 0, 1, 2 mod 3
+    int retiredCount;
+    uint64_t seed;
+    struct SkipList* list;
+    struct SLThread* next;                // Registry link
+};
+
+static inline struct SkipNode* ptrOf(uintptr_t word) {
+    return (struct SkipNode*)(word & ~(uintptr_t)1);
+}
+
+static inline int isMarked(uintptr_t word) {
+    return (int)(word & 1);
+}
+
+static struct SkipNode* newNode(int key, int value, int topLevel) {
+    struct SkipNode* node = (struct SkipNode*)malloc(sizeof(struct SkipNode) + (topLevel + 1) * sizeof(uintptr_t));
+    if (node == NULL) return NULL;
+    node->key = key;
+    node->value = value;
+    node->topLevel = topLevel;
+    atomic_init(&node->state, 0);
+    node->retiredNext = NULL;
+    return node;
+}
+
+int sl_init(struct SkipList* sl) {
+    sl->head = newNode(0, 0, MAX_LEVEL - 1);
+    if (sl->head == NULL) return -1;
+    for (int i = 0; i < MAX_LEVEL; i++) atomic_init(&sl->head->next[i], 0);
+    atomic_init(&sl->epoch, 0);
+    atomic_init(&sl->threads, NULL);
+    return 0;
+}
+
+// Register the calling thread. Returns NULL if out of memory.
+struct SLThread* sl_thread_attach(struct SkipList* sl) {
+    static atomic_uint seeds = 1;
+    struct SLThread* t = (struct SLThread*)aligned_alloc(CACHE_LINE, sizeof(struct SLThread));
+    if (t == NULL) return NULL;
+    atomic_init(&t->announced, 0);
+    t->epoch = 0;
+    t->limbo[0] = t->limbo[1] = t->limbo[2] = NULL;
+    t->retiredCount = 0;
+    t->seed = 0x9E3779B97F4A7C15ULL * atomic_fetch_add(&seeds, 1);
+    t->list = sl;
+    t->next = atomic_load(&sl->threads);
+    while (!atomic_compare_exchange_weak(&sl->threads, &t->next, t)) {
+    }
+    return t;
+}
+
+static void freeChain(struct SkipNode* node) {
+    while (node != NULL) {
+        struct SkipNode* next = node->retiredNext;
+        free(node);
+        node = next;
+    }
+}
+
+// Free every node and thread record. No thread may be using the list.
+void sl_destroy(struct SkipList* sl) {
+    struct SkipNode* node = sl->head;
+    while (node != NULL) {
+        struct SkipNode* next = ptrOf(atomic_load_explicit(&node->next[0], memory_order_relaxed));
+        free(node);
+        node = next;
+    }
+    struct SLThread* t = atomic_load(&sl->threads);
+    while (t != NULL) {
+        struct SLThread* next = t->next;
+        for (int i = 0; i < 3; i++) freeChain(t->limbo[i]);
+        free(t);
+        t = next;
+    }
+    sl->head = NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Epochs
+// ---------------------------------------------------------------------------
+
+static void enter(struct SLThread* t) {
+    unsigned e = atomic_load_explicit(&t->list->epoch, memory_order_acquire);
+    atomic_store_explicit(&t->announced, e * 2 + 1, memory_order_seq_cst);
+    if (t->epoch != e) {
+        // Nodes retired two or more epochs ago can no longer be reached
+        freeChain(t->limbo[(e + 1) % 3]);
+        t->limbo[(e + 1) % 3] = NULL;
+        t->epoch = e;
+    }
+}
+
+static void leave(struct SLThread* t) {
+    atomic_store_explicit(&t->announced, 0, memory_order_release);
+}
+
+// Advance the global epoch if every thread inside an operation has seen it
+static void tryAdvance(struct SkipList* sl) {
+    unsigned e = atomic_load_explicit(&sl->epoch, memory_order_seq_cst);
+    for (struct SLThread* t = atomic_load(&sl->threads); t != NULL; t = t->next) {
+        unsigned a = atomic_load_explicit(&t->announced, memory_order_seq_cst);
+        if (a != 0 && a != e * 2 + 1) return;
+    }
+    atomic_compare_exchange_strong(&sl->epoch, &e, e + 1);
+}
+
+// node is already unlinked. File it under the current global epoch: the
+// epoch this thread announced may be one behind, while threads that
+// entered in the newer one can still hold node.
+static void retire(struct SLThread* t, struct SkipNode* node) {
+    int bucket = (int)(atomic_load_explicit(&t->list->epoch, memory_order_seq_cst) % 3);
+    node->retiredNext = t->limbo[bucket];
+    t->limbo[bucket] = node;
+    if (++t->retiredCount % RETIRE_BATCH == 0) tryAdvance(t->list);
+}
+
+// ---------------------------------------------------------------------------
+// Operations
+// ---------------------------------------------------------------------------
+
+static int randomLevel(struct SLThread* t) {
+    uint64_t r = t->seed;
+    r ^= r << 13;
+    r ^= r >> 7;
+    r ^= r << 17;
+    t->seed = r;
+    return __builtin_ctzll(r | (uint64_t)1 << (MAX_LEVEL - 1));  // Level k with probability 2^-(k+1)
+}
+
+// Fill preds/succs with the nodes around key on every level, unlinking any
+// marked node on the way. Returns 1 if an unmarked node holds key.
+//
+// With a victim, also step over other nodes with the same key: an insert
+// racing with the victim's deletion can link a new node with its key in
+// front of it on an upper level, and the victim must still be unlinked there.
+static int findFrom(struct SkipList* sl, int key, const struct SkipNode* victim,
+                    struct SkipNode** preds, struct SkipNode** succs) {
+retry:;
+    struct SkipNode* pred = sl->head;
+    struct SkipNode* curr = NULL;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+        curr = ptrOf(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr != NULL) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (isMarked(succ)) {
+                // curr is deleted: unlink it at this level (fails if pred is deleted too)
+                uintptr_t expected = (uintptr_t)curr;
+                if (!atomic_compare_exchange_strong_explicit(&pred->next[level], &expected, (uintptr_t)ptrOf(succ),
+                                                             memory_order_acq_rel, memory_order_acquire)) {
+                    goto retry;
+                }
+                curr = ptrOf(succ);
+            } else if (curr->key < key || (victim != NULL && curr->key == key)) {
+                pred = curr;
+                curr = ptrOf(succ);
+            } else {
+                break;
+            }
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return curr != NULL && curr->key == key;
+}
+
+static int find(struct SkipList* sl, int key, struct SkipNode** preds, struct SkipNode** succs) {
+    return findFrom(sl, key, NULL, preds, succs);
+}
+
+// Record that the insert or the delete of node is done. The second one to
+// finish unlinks it, after which no new link to it can appear, and retires it.
+static void finish(struct SLThread* t, struct SkipNode* node, int done) {
+    int before = atomic_fetch_or_explicit(&node->state, done, memory_order_acq_rel);
+    if ((before | done) != (INSERT_DONE | DELETE_DONE)) return;
+    struct SkipNode* preds[MAX_LEVEL];
+    struct SkipNode* succs[MAX_LEVEL];
+    findFrom(t->list, node->key, node, preds, succs);  // Unlink it from every level
+    retire(t, node);
+}
+
+// Mark node deleted. Returns 1 if this thread's mark on level 0 won.
+static int removeNode(struct SLThread* t, struct SkipNode* node) {
+    for (int level = node->topLevel; level >= 1; level--) {
+        uintptr_t succ = atomic_load_explicit(&node->next[level], memory_order_acquire);
+        while (!isMarked(succ)) {
+            atomic_compare_exchange_weak_explicit(&node->next[level], &succ, succ | 1,
+                                                  memory_order_acq_rel, memory_order_acquire);
+        }
+    }
+    uintptr_t succ = atomic_load_explicit(&node->next[0], memory_order_acquire);
+    for (;;) {
+        if (isMarked(succ)) return 0;  // Someone else deleted it
+        if (atomic_compare_exchange_weak_explicit(&node->next[0], &succ, succ | 1,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            break;
+        }
+    }
+    finish(t, node, DELETE_DONE);
+    return 1;
+}
+
+// Insert key -> value. Returns 1, 0 if the key is already present, or -1 if
+// out of memory.
+int sl_insert(struct SLThread* t, int key, int value) {
+    struct SkipList* sl = t->list;
+    struct SkipNode* preds[MAX_LEVEL];
+    struct SkipNode* succs[MAX_LEVEL];
+    int topLevel = randomLevel(t);
+    struct SkipNode* node = NULL;
+    enter(t);
+    for (;;) {
+        if (find(sl, key, preds, succs)) {
+            free(node);  // Never published
+            leave(t);
+            return 0;
+        }
+        if (node == NULL && (node = newNode(key, value, topLevel)) == NULL) {
+            leave(t);
+            return -1;
+        }
+        for (int level = 0; level <= topLevel; level++) {
+            atomic_store_explicit(&node->next[level], (uintptr_t)succs[level], memory_order_relaxed);
+        }
+        uintptr_t expected = (uintptr_t)succs[0];
+        if (atomic_compare_exchange_strong_explicit(&preds[0]->next[0], &expected, (uintptr_t)node,
+                                                    memory_order_acq_rel, memory_order_acquire)) {
+            break;  // Linked at level 0: the key is in the list
+        }
+    }
+    // Link the upper levels. If the node gets deleted meanwhile, stop.
+    for (int level = 1; level <= topLevel; level++) {
+        for (;;) {
+            // Point it at the successor from the latest find first; a find
+            // made while linking a lower level leaves next[level] stale.
+            uintptr_t old = atomic_load_explicit(&node->next[level], memory_order_acquire);
+            if (isMarked(old)) goto done;
+            if (old != (uintptr_t)succs[level] &&
+                !atomic_compare_exchange_strong_explicit(&node->next[level], &old, (uintptr_t)succs[level],
+                                                         memory_order_acq_rel, memory_order_acquire)) {
+                goto done;  // Marked by a delete
+            }
+            uintptr_t expected = (uintptr_t)succs[level];
+            if (atomic_compare_exchange_strong_explicit(&preds[level]->next[level], &expected, (uintptr_t)node,
+                                                        memory_order_acq_rel, memory_order_acquire)) {
+                break;
+            }
+            if (!find(sl, key, preds, succs) || succs[0] != node) goto done;
+        }
+    }
+done:
+    finish(t, node, INSERT_DONE);
+    leave(t);
+    return 1;
+}
+
+// Delete key. Returns 1 if this call removed it, 0 if it was not present.
+int sl_delete(struct SLThread* t, int key) {
+    struct SkipNode* preds[MAX_LEVEL];
+    struct SkipNode* succs[MAX_LEVEL];
+    enter(t);
+    int removed = find(t->list, key, preds, succs) && removeNode(t, succs[0]);
+    leave(t);
+    return removed;
+}
+
+// Look up key without modifying the list. Returns 1 and stores the value if
+// present.
+int sl_search(struct SLThread* t, int key, int* value) {
+    enter(t);
+    struct SkipNode* pred = t->list->head;
+    struct SkipNode* curr = NULL;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+        curr = ptrOf(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr != NULL) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (!isMarked(succ) && curr->key >= key) break;
+            if (!isMarked(succ)) pred = curr;
+            curr = ptrOf(succ);
+        }
+    }
+    int found = curr != NULL && curr->key == key;
+    if (found) *value = curr->value;
+    leave(t);
+    return found;
+}
+
+// Remove and return the smallest key (priority-queue mode). Returns 1, or 0
+// if the list is empty.
+int sl_pop_min(struct SLThread* t, int* key, int* value) {
+    enter(t);
+    struct SkipNode* curr = ptrOf(atomic_load_explicit(&t->list->head->next[0], memory_order_acquire));
+    while (curr != NULL) {
+        uintptr_t succ = atomic_load_explicit(&curr->next[0], memory_order_acquire);
+        if (!isMarked(succ)) {
+            int k = curr->key, v = curr->value;
+            if (removeNode(t, curr)) {
+                *key = k;
+                *value = v;
+                leave(t);
+                return 1;
+            }
+        }
+        curr = ptrOf(atomic_load_explicit(&curr->next[0], memory_order_acquire));
+    }
+    leave(t);
+    return 0;
+}
+
+// Call fn for every key in [lo, hi] in ascending order; stops early if fn
+// returns nonzero. Concurrent updates may or may not be seen. Returns the
+// number of keys visited.
+int sl_range(struct SLThread* t, int lo, int hi, int (*fn)(int key, int value, void* context), void* context) {
+    enter(t);
+    struct SkipNode* pred = t->list->head;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+        struct SkipNode* curr = ptrOf(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr != NULL && curr->key < lo) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (!isMarked(succ)) pred = curr;  // Never descend from a deleted node
+            curr = ptrOf(succ);
+        }
+    }
+    int visited = 0;
+    struct SkipNode* curr = ptrOf(atomic_load_explicit(&pred->next[0], memory_order_acquire));
+    while (curr != NULL && curr->key <= hi) {
+        uintptr_t succ = atomic_load_explicit(&curr->next[0], memory_order_acquire);
+        if (curr->key >= lo && !isMarked(succ)) {
+            visited++;
+            if (fn(curr->key, curr->value, context)) break;
+        }
+        curr = ptrOf(succ);
+    }
+    leave(t);
+    return visited;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: operations per second for several search/insert/delete mixes,
+// and for priority-queue use, on 1 .. all cores
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+#define MAX_THREADS 64
+
+struct MixJob {
+    struct SkipList* list;
+    int searchPercent;       // The rest is split evenly between insert and delete
+    int keyRange;            // -1 means priority-queue mode (insert + pop_min)
+    int ops;
+    uint64_t seed;
+    long long checksum;
+};
+
+static void* runMix(void* arg) {
+    struct MixJob* job = (struct MixJob*)arg;
+    struct SLThread* t = sl_thread_attach(job->list);
+    if (t == NULL) return NULL;
+    long long checksum = 0;
+    for (int i = 0; i < job->ops; i++) {
+        uint64_t r = nextRandom(&job->seed);
+        int key = (int)((r >> 32) % (uint64_t)(job->keyRange > 0 ? job->keyRange : 1 << 30));
+        int value;
+        if (job->keyRange < 0) {
+            if (i & 1) {
+                if (sl_pop_min(t, &key, &value)) checksum += key;
+            } else {
+                sl_insert(t, key, key);
+            }
+        } else if ((int)(r % 100) < job->searchPercent) {
+            checksum += sl_search(t, key, &value);
+        } else if (r & 0x100) {
+            checksum += sl_insert(t, key, key);
+        } else {
+            checksum += sl_delete(t, key);
+        }
+    }
+    job->checksum = checksum;
+    return NULL;
+}
+
+static double runThreads(struct SkipList* sl, int threads, int totalOps, int searchPercent, int keyRange) {
+    struct MixJob jobs[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    int started[MAX_THREADS];
+    double t0 = nowSeconds();
+    for (int i = 0; i < threads; i++) {
+        jobs[i].list = sl;
+        jobs[i].searchPercent = searchPercent;
+        jobs[i].keyRange = keyRange;
+        jobs[i].ops = totalOps / threads;
+        jobs[i].seed = 0x2545F4914F6CDD1DULL * (uint64_t)(i + 1);
+        started[i] = pthread_create(&ids[i], NULL, runMix, &jobs[i]) == 0;
+        if (!started[i]) runMix(&jobs[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        if (started[i]) pthread_join(ids[i], NULL);
+    }
+    return totalOps / (nowSeconds() - t0);
+}
+
+static void runBenchmark(int keyRange, int totalOps, int maxThreads) {
+    const char* names[] = {"90% search", "50% search", "0% search", "insert+pop_min"};
+    int searchPercents[] = {90, 50, 0, 0};
+    printf("%d keys (half preloaded), %d ops per run, Mops/s\n", keyRange, totalOps);
+    printf("%-16s", "mix");
+    for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        printf(" %7d thr", threads);
+        if (threads == maxThreads) break;
+    }
+    printf("\n");
+    for (int m = 0; m < 4; m++) {
+        printf("%-16s", names[m]);
+        for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+            struct SkipList sl;
+            sl_init(&sl);
+            struct SLThread* loader = sl_thread_attach(&sl);
+            for (int k = 0; k < keyRange; k += 2) sl_insert(loader, k, k);
+            double rate = runThreads(&sl, threads, totalOps, searchPercents[m], m == 3 ? -1 : keyRange);
+            sl_destroy(&sl);
+            printf(" %11.2f", rate / 1e6);
+            if (threads == maxThreads) break;
+        }
+        printf("\n");
+    }
+}
+
+static int printEntry(int key, int value, void* context) {
+    (void)context;
+    printf(" %d:%d", key, value);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [keys] [ops] [max threads]
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        int keyRange = argc > 2 ? atoi(argv[2]) : 1000000;
+        int totalOps = argc > 3 ? atoi(argv[3]) : 4000000;
+        int maxThreads = argc > 4 ? atoi(argv[4]) : (int)(cpus > 0 ? cpus : 1);
+        if (maxThreads < 1) maxThreads = 1;
+        if (maxThreads > MAX_THREADS) maxThreads = MAX_THREADS;
+        if (keyRange < 1) keyRange = 1;
+        runBenchmark(keyRange, totalOps, maxThreads);
+        return 0;
+    }
+
+    struct SkipList sl;
+    sl_init(&sl);
+    struct SLThread* t = sl_thread_attach(&sl);
+    int keys[] = {30, 10, 50, 20, 40};
+    for (int i = 0; i < 5; i++) sl_insert(t, keys[i], keys[i] * 10);
+    sl_delete(t, 20);
+
+    int value;
+    printf("40 is %s\n", sl_search(t, 40, &value) ? "present" : "missing");   // present
+    printf("Keys in [15, 45]:");
+    sl_range(t, 15, 45, printEntry, NULL);   // 30:300 40:400
+    printf("\n");
+
+    int key;
+    printf("pop_min order:");
+    while (sl_pop_min(t, &key, &value)) printf(" %d", key);   // 10 30 40 50
+    printf("\n");
+    sl_destroy(&sl);
+    return 0;
+}
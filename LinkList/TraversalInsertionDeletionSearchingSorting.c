@@ -1,5 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "NodePool.h"
 
 // Define the structure for a node in the linked list
 struct Node {
@@ -7,25 +10,252 @@ struct Node {
     struct Node* next;  // Pointer to the next node
 };
 
+// List header: the tail pointer makes appends O(1) and the length lets
+// position checks fail without a walk. The list owns the pool its nodes
+// are allocated from.
+struct LinkedList {
+    struct Node* head;
+    struct Node* tail;
+    int length;
+    struct NodePool pool;
+    struct ListIndex* index;  // Optional key index, NULL when turned off
+};
+
+// ---------------------------------------------------------------------------
+// Optional hash index: key -> first node holding the key and the node before
+// it, so searchNode and deleteNode need no walk
+// ---------------------------------------------------------------------------
+
+// One slot per distinct key. `count` is how many nodes hold the key, `node`
+// is the first of them in list order and `prev` the node before that one
+// (NULL when it is the head).
+struct IndexEntry {
+    struct Node* node;  // NULL for an empty slot
+    struct Node* prev;
+    int key;
+    int count;
+};
+
+// Open addressing with linear probing. Growing does not rehash everything at
+// once: the old table is kept, and every update moves INDEX_MIGRATE_STEP of
+// its slots into the new one, so no single insert pays for the whole resize.
+// Until the move is done, lookups check both tables.
+struct ListIndex {
+    struct IndexEntry* slots;
+    size_t capacity;          // Power of two
+    size_t used;
+    struct IndexEntry* old;   // Table being drained, or NULL
+    size_t oldCapacity;
+    size_t migrated;          // Old slots below this one have been moved
+};
+
+#define INDEX_INITIAL_CAPACITY 16
+#define INDEX_MIGRATE_STEP 16
+#define INDEX_TOMBSTONE ((struct Node*)1)  // Slot of the old table whose entry was removed or moved
+
+static inline size_t indexHash(int key, size_t capacity) {
+    uint64_t h = (uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(h ^ h >> 32) & (capacity - 1);
+}
+
+// The slot holding key in one table, or NULL
+static struct IndexEntry* probe(struct IndexEntry* slots, size_t capacity, int key) {
+    for (size_t i = indexHash(key, capacity);; i = (i + 1) & (capacity - 1)) {
+        if (slots[i].node == NULL) return NULL;
+        if (slots[i].node != INDEX_TOMBSTONE && slots[i].key == key) return &slots[i];
+    }
+}
+
+static struct IndexEntry* indexFind(struct ListIndex* index, int key) {
+    struct IndexEntry* entry = probe(index->slots, index->capacity, key);
+    if (entry == NULL && index->old != NULL) {
+        entry = probe(index->old, index->oldCapacity, key);
+    }
+    return entry;
+}
+
+// Put an entry whose key is in neither table into the current table
+static struct IndexEntry* placeEntry(struct ListIndex* index, const struct IndexEntry* entry) {
+    size_t i = indexHash(entry->key, index->capacity);
+    while (index->slots[i].node != NULL) i = (i + 1) & (index->capacity - 1);
+    index->slots[i] = *entry;
+    index->used++;
+    return &index->slots[i];
+}
+
+// Move up to `steps` slots of the old table into the current one
+static void migrateSome(struct ListIndex* index, size_t steps) {
+    while (index->old != NULL && steps-- > 0) {
+        struct IndexEntry* entry = &index->old[index->migrated++];
+        if (entry->node != NULL && entry->node != INDEX_TOMBSTONE) {
+            placeEntry(index, entry);
+            entry->node = INDEX_TOMBSTONE;  // The copy in the new table is now the live one
+        }
+        if (index->migrated == index->oldCapacity) {
+            free(index->old);
+            index->old = NULL;
+        }
+    }
+}
+
+// Add a key that is in neither table. Returns the new slot, or NULL if the
+// table had to grow and could not.
+static struct IndexEntry* addEntry(struct ListIndex* index, int key, struct Node* node, struct Node* prev) {
+    if ((index->used + 1) * 4 > index->capacity * 3) {
+        migrateSome(index, SIZE_MAX);  // Finish any earlier move first
+        struct IndexEntry* slots = (struct IndexEntry*)calloc(index->capacity * 2, sizeof(struct IndexEntry));
+        if (slots == NULL) return NULL;
+        index->old = index->slots;
+        index->oldCapacity = index->capacity;
+        index->migrated = 0;
+        index->slots = slots;
+        index->capacity *= 2;
+        index->used = 0;
+    }
+    struct IndexEntry entry = {node, prev, key, 1};
+    return placeEntry(index, &entry);
+}
+
+// Remove an entry. The old table only gets a tombstone, since shifting its
+// entries back could move them below the migration point.
+static void removeEntry(struct ListIndex* index, struct IndexEntry* entry) {
+    if (index->old != NULL && entry >= index->old && entry < index->old + index->oldCapacity) {
+        entry->node = INDEX_TOMBSTONE;
+        return;
+    }
+    size_t mask = index->capacity - 1;
+    size_t hole = (size_t)(entry - index->slots);
+    for (size_t i = (hole + 1) & mask; index->slots[i].node != NULL; i = (i + 1) & mask) {
+        // Shift an entry back into the hole unless that would put it before its home slot
+        size_t home = indexHash(index->slots[i].key, index->capacity);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            index->slots[hole] = index->slots[i];
+            hole = i;
+        }
+    }
+    index->slots[hole].node = NULL;
+    index->used--;
+}
+
+// Turn the index off and free it
+void list_disable_index(struct LinkedList* list) {
+    if (list->index == NULL) return;
+    free(list->index->old);
+    free(list->index->slots);
+    free(list->index);
+    list->index = NULL;
+}
+
+// Record that node's predecessor is now prev, if node is the first holder of its key
+static void indexSetPrev(struct ListIndex* index, struct Node* node, struct Node* prev) {
+    if (node == NULL) return;
+    struct IndexEntry* entry = indexFind(index, node->data);
+    if (entry != NULL && entry->node == node) entry->prev = prev;
+}
+
+// Record a node just linked in after prev. `first` says whether it now comes
+// before every other node with the same key. If the table cannot grow the
+// index is dropped and the list goes back to scanning.
+static void indexInsert(struct LinkedList* list, struct Node* node, struct Node* prev, int first) {
+    struct ListIndex* index = list->index;
+    migrateSome(index, INDEX_MIGRATE_STEP);
+    indexSetPrev(index, node->next, node);
+    struct IndexEntry* entry = indexFind(index, node->data);
+    if (entry != NULL) {
+        entry->count++;
+        if (first) {
+            entry->node = node;
+            entry->prev = prev;
+        }
+    } else if (addEntry(index, node->data, node, prev) == NULL) {
+        list_disable_index(list);
+    }
+}
+
+// Turn on the hash index, built from the current contents in O(n). It is kept
+// up to date by the inserts and deleteNode; reverseList and sortList rebuild
+// it. Returns 0, or -1 if out of memory (the list then works without it).
+int list_enable_index(struct LinkedList* list) {
+    list_disable_index(list);
+    size_t capacity = INDEX_INITIAL_CAPACITY;
+    while (capacity * 3 < ((size_t)list->length + 1) * 4) capacity *= 2;
+    struct ListIndex* index = (struct ListIndex*)malloc(sizeof(struct ListIndex));
+    struct IndexEntry* slots = (struct IndexEntry*)calloc(capacity, sizeof(struct IndexEntry));
+    if (index == NULL || slots == NULL) {
+        free(index);
+        free(slots);
+        return -1;
+    }
+    index->slots = slots;
+    index->capacity = capacity;
+    index->used = 0;
+    index->old = NULL;
+    index->oldCapacity = 0;
+    index->migrated = 0;
+    list->index = index;
+
+    struct Node* prev = NULL;
+    for (struct Node* node = list->head; node != NULL; prev = node, node = node->next) {
+        struct IndexEntry* entry = indexFind(index, node->data);
+        if (entry != NULL) {
+            entry->count++;
+        } else {
+            addEntry(index, node->data, node, prev);  // Sized above, never grows
+        }
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// List operations
+// ---------------------------------------------------------------------------
+
+// Initialize an empty linked list
+void initList(struct LinkedList* list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->index = NULL;
+    poolInit(&list->pool, sizeof(struct Node), POOL_DEFAULT_SLAB_NODES);
+}
+
+// Free every node of the list at once by releasing the pool's slabs
+void list_destroy(struct LinkedList* list) {
+    list_disable_index(list);
+    poolDestroy(&list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+}
+
 // Function to insert a node at the beginning of the linked list
-void insertAtBeginning(struct Node** head_ref, int new_data) {
-    // Allocate memory for the new node
-    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+void insertAtBeginning(struct LinkedList* list, int new_data) {
+    // Take a node from the list's pool
+    struct Node* new_node = (struct Node*)poolAlloc(&list->pool);
+    if (new_node == NULL) return;
     
     // Set the data of the new node
     new_node->data = new_data;
     
     // Make the new node point to the current head
-    new_node->next = (*head_ref);
+    new_node->next = list->head;
     
     // Move the head to point to the new node
-    (*head_ref) = new_node;
+    list->head = new_node;
+    
+    // The first node of an empty list is also its last
+    if (list->tail == NULL) {
+        list->tail = new_node;
+    }
+    list->length++;
+    if (list->index != NULL) indexInsert(list, new_node, NULL, 1);
 }
 
 // Function to insert a node at the end of the linked list
-void insertAtEnd(struct Node** head_ref, int new_data) {
-    // Allocate memory for the new node
-    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+void insertAtEnd(struct LinkedList* list, int new_data) {
+    // Take a node from the list's pool
+    struct Node* new_node = (struct Node*)poolAlloc(&list->pool);
+    if (new_node == NULL) return;
     
     // Set the data of the new node
     new_node->data = new_data;
@@ -34,63 +264,149 @@ void insertAtEnd(struct Node** head_ref, int new_data) {
     new_node->next = NULL;
     
     // If the list is empty, make the new node the head
-    if (*head_ref == NULL) {
-        *head_ref = new_node;
-        return;
-    }
-    
-    // Traverse to the last node
-    struct Node* last = *head_ref;
-    while (last->next != NULL) {
-        last = last->next;
+    if (list->head == NULL) {
+        list->head = new_node;
+    } else {
+        // Link after the current last node, no traversal needed
+        list->tail->next = new_node;
     }
     
-    // Make the last node point to the new node
-    last->next = new_node;
+    struct Node* prev = list->tail;
+    list->tail = new_node;
+    list->length++;
+    if (list->index != NULL) indexInsert(list, new_node, prev, 0);
 }
 
-// Function to insert a node at a specific position in the linked list
-void insertAtPosition(struct Node** head_ref, int new_data, int position) {
-    // Allocate memory for the new node
-    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+// Function to insert a node at a specific position in the linked list.
+// Returns 0 on success and -1 if the position is past the end of the list.
+int insertAtPosition(struct LinkedList* list, int new_data, int position) {
+    // If the position is out of bounds, fail without walking the list
+    if (position < 0 || position > list->length) {
+        return -1;
+    }
+    
+    // The ends are handled in O(1)
+    if (position == 0) {
+        insertAtBeginning(list, new_data);
+        return 0;
+    }
+    if (position == list->length) {
+        insertAtEnd(list, new_data);
+        return 0;
+    }
+    
+    // Take a node from the list's pool
+    struct Node* new_node = (struct Node*)poolAlloc(&list->pool);
+    if (new_node == NULL) return -1;
     
     // Set the data of the new node
     new_node->data = new_data;
     
-    // If the position is 0, insert at the beginning
-    if (position == 0) {
-        new_node->next = (*head_ref);
-        (*head_ref) = new_node;
-        return;
+    // With the index on, note whether the walk passes an earlier node with the same key
+    struct Node* holder = NULL;
+    int passed = 0;
+    if (list->index != NULL) {
+        struct IndexEntry* entry = indexFind(list->index, new_data);
+        if (entry != NULL) holder = entry->node;
     }
     
     // Traverse to the node just before the position
-    struct Node* current = *head_ref;
-    for (int i = 0; i < position - 1 && current != NULL; i++) {
+    struct Node* current = list->head;
+    passed |= current == holder;
+    for (int i = 0; i < position - 1; i++) {
         current = current->next;
-    }
-    
-    // If the position is out of bounds, do nothing
-    if (current == NULL) {
-        free(new_node);
-        return;
+        passed |= current == holder;
     }
     
     // Insert the new node at the position
     new_node->next = current->next;
     current->next = new_node;
+    list->length++;
+    if (list->index != NULL) indexInsert(list, new_node, current, !passed);
+    return 0;
+}
+
+// Build a list from an array in one pass (the list must be initialized and empty)
+void list_from_array(struct LinkedList* list, const int* values, int n) {
+    struct Node* last = NULL;
+    for (int i = 0; i < n; i++) {
+        struct Node* new_node = (struct Node*)poolAlloc(&list->pool);
+        if (new_node == NULL) break;
+        new_node->data = values[i];
+        if (last == NULL) {
+            list->head = new_node;
+        } else {
+            last->next = new_node;
+        }
+        last = new_node;
+        list->length++;
+    }
+    if (last != NULL) {
+        last->next = NULL;
+        list->tail = last;
+    }
+    if (list->index != NULL) list_enable_index(list);
+}
+
+// deleteNode through the index: the node and its predecessor come from the
+// table, and only a key held by several nodes needs a walk, to its next holder
+static void deleteIndexed(struct LinkedList* list, int key) {
+    struct ListIndex* index = list->index;
+    migrateSome(index, INDEX_MIGRATE_STEP);
+    struct IndexEntry* entry = indexFind(index, key);
+    if (entry == NULL) return;
+    struct Node* temp = entry->node;
+    struct Node* prev = entry->prev;
+    struct Node* next = temp->next;
+    
+    // Unlink the node
+    if (prev == NULL) {
+        list->head = next;
+    } else {
+        prev->next = next;
+    }
+    if (list->tail == temp) {
+        list->tail = prev;
+    }
+    
+    if (--entry->count == 0) {
+        removeEntry(index, entry);
+    } else {
+        // Every other holder comes later in the list
+        struct Node* before = prev;
+        struct Node* node = next;
+        while (node->data != key) {
+            before = node;
+            node = node->next;
+        }
+        entry->node = node;
+        entry->prev = before;
+    }
+    if (next != NULL && next->data != key) indexSetPrev(index, next, prev);
+    
+    poolFree(&list->pool, temp);
+    list->length--;
 }
 
 // Function to delete a node with a given value from the linked list
-void deleteNode(struct Node** head_ref, int key) {
+void deleteNode(struct LinkedList* list, int key) {
+    if (list->index != NULL) {
+        deleteIndexed(list, key);
+        return;
+    }
+    
     // Store the head node
-    struct Node* temp = *head_ref;
+    struct Node* temp = list->head;
     struct Node* prev = NULL;
     
     // If the head node itself holds the key to be deleted
     if (temp != NULL && temp->data == key) {
-        *head_ref = temp->next; // Change head
-        free(temp);             // Free old head
+        list->head = temp->next;        // Change head
+        if (list->tail == temp) {
+            list->tail = NULL;          // The list is now empty
+        }
+        poolFree(&list->pool, temp);    // Return old head to the pool
+        list->length--;
         return;
     }
     
@@ -105,14 +421,22 @@ void deleteNode(struct Node** head_ref, int key) {
     
     // Unlink the node from the linked list
     prev->next = temp->next;
+    if (list->tail == temp) {
+        list->tail = prev;
+    }
     
-    // Free the memory of the deleted node
-    free(temp);
+    // Return the deleted node to the pool
+    poolFree(&list->pool, temp);
+    list->length--;
 }
 
 // Function to search for a node with a given value in the linked list
-int searchNode(struct Node* head, int key) {
-    struct Node* current = head;
+int searchNode(struct LinkedList* list, int key) {
+    if (list->index != NULL) {
+        return indexFind(list->index, key) != NULL;
+    }
+    
+    struct Node* current = list->head;
     
     // Traverse the list
     while (current != NULL) {
@@ -126,7 +450,8 @@ int searchNode(struct Node* head, int key) {
 }
 
 // Function to traverse and print the linked list
-void printList(struct Node* node) {
+void printList(struct LinkedList* list) {
+    struct Node* node = list->head;
     while (node != NULL) {
         printf("%d -> ", node->data);
         node = node->next;
@@ -135,11 +460,14 @@ void printList(struct Node* node) {
 }
 
 // Function to reverse the linked list
-void reverseList(struct Node** head_ref) {
+void reverseList(struct LinkedList* list) {
     struct Node* prev = NULL;
-    struct Node* current = *head_ref;
+    struct Node* current = list->head;
     struct Node* next = NULL;
     
+    // The old first node becomes the last one
+    list->tail = list->head;
+    
     while (current != NULL) {
         next = current->next;  // Store the next node
         current->next = prev;  // Reverse the current node's pointer
@@ -147,44 +475,651 @@ void reverseList(struct Node** head_ref) {
         current = next;
     }
     
-    *head_ref = prev;  // Update the head to the new first node
+    list->head = prev;  // Update the head to the new first node
+    
+    // Every predecessor changed
+    if (list->index != NULL) list_enable_index(list);
 }
 
-int main() {
-    // Initialize an empty linked list
+// Comparator for sortList: negative if a sorts before b, 0 if equal, positive otherwise
+typedef int (*CompareFn)(int a, int b);
+
+// With no comparator, plain ascending integer order is used
+#define SORTS_BEFORE(compare, a, b) ((compare) != NULL ? (compare)((a), (b)) < 0 : (a) < (b))
+
+// Merge two sorted, NULL-terminated runs. On ties the node from `left` goes
+// first, which keeps the sort stable. The last node is stored in *tail_ref.
+static struct Node* mergeRuns(struct Node* left, struct Node* leftTail,
+                              struct Node* right, struct Node* rightTail,
+                              CompareFn compare, struct Node** tail_ref) {
+    struct Node dummy;
+    struct Node* tail = &dummy;
+    
+    while (left != NULL && right != NULL) {
+        if (SORTS_BEFORE(compare, right->data, left->data)) {
+            tail->next = right;
+            right = right->next;
+        } else {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+    
+    // Link whatever is left over; its run's tail is the merged tail
+    if (left != NULL) {
+        tail->next = left;
+        *tail_ref = leftTail;
+    } else {
+        tail->next = right;
+        *tail_ref = rightTail;
+    }
+    return dummy.next;
+}
+
+// Detach the next natural run starting at *rest_ref and return it in sorted order.
+// A strictly descending run is reversed; strictness keeps equal keys in order.
+static struct Node* takeRun(struct Node** rest_ref, CompareFn compare, struct Node** tail_ref) {
+    struct Node* head = *rest_ref;
+    struct Node* current = head;
+    
+    if (current->next != NULL && SORTS_BEFORE(compare, current->next->data, current->data)) {
+        // Descending run: reverse it while walking
+        struct Node* reversed = NULL;
+        struct Node* next;
+        do {
+            next = current->next;
+            current->next = reversed;
+            reversed = current;
+            current = next;
+        } while (current != NULL && SORTS_BEFORE(compare, current->data, reversed->data));
+        *rest_ref = current;
+        head->next = NULL;  // The first node is now the last one
+        *tail_ref = head;
+        return reversed;
+    }
+    
+    // Ascending (non-descending) run
+    while (current->next != NULL && !SORTS_BEFORE(compare, current->next->data, current->data)) {
+        current = current->next;
+    }
+    *rest_ref = current->next;
+    current->next = NULL;
+    *tail_ref = current;
+    return head;
+}
+
+// Function to sort the linked list in place by relinking nodes (no allocation).
+// Bottom-up natural merge sort: runs that are already in order are found in a
+// single pass and merged like a binary counter, so sorted input costs O(n) and
+// the worst case is O(n log n) with no recursion. The sort is stable.
+void sortList(struct LinkedList* list, CompareFn compare) {
+    // pending[i] holds a merged run built from up to 2^i natural runs;
+    // higher slots always hold earlier parts of the list
+    struct Node* pending[64] = {NULL};
+    struct Node* pendingTail[64];
+    struct Node* rest = list->head;
+    int used = 0;
+    
+    while (rest != NULL) {
+        struct Node* carryTail;
+        struct Node* carry = takeRun(&rest, compare, &carryTail);
+        int i;
+        for (i = 0; i < used && pending[i] != NULL; i++) {
+            carry = mergeRuns(pending[i], pendingTail[i], carry, carryTail, compare, &carryTail);
+            pending[i] = NULL;
+        }
+        if (i == used) used++;
+        pending[i] = carry;
+        pendingTail[i] = carryTail;
+    }
+    
+    // Merge the remaining runs, earlier (higher) slots on the left
+    struct Node* result = NULL;
+    struct Node* tail = NULL;
+    for (int i = 0; i < used; i++) {
+        if (pending[i] == NULL) continue;
+        if (result == NULL) {
+            result = pending[i];
+            tail = pendingTail[i];
+        } else {
+            result = mergeRuns(pending[i], pendingTail[i], result, tail, compare, &tail);
+        }
+    }
+    
+    list->head = result;
+    list->tail = tail;
+    if (list->index != NULL) list_enable_index(list);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks: pooled nodes against one malloc/free per node, O(1) tail
+// appends against walking to the end of the list, sortList against
+// copying into an array for qsort, and keyed operations with and without
+// the hash index
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// The previous allocation strategy, reduced to the operations the benchmark needs
+static void mallocInsertAtBeginning(struct Node** head_ref, int new_data) {
+    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+    new_node->data = new_data;
+    new_node->next = *head_ref;
+    *head_ref = new_node;
+}
+
+static void mallocDeleteHead(struct Node** head_ref) {
+    struct Node* temp = *head_ref;
+    *head_ref = temp->next;
+    free(temp);
+}
+
+// The previous append: walk from the head to the last node every time
+static void walkingInsertAtEnd(struct Node** head_ref, int new_data) {
+    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+    new_node->data = new_data;
+    new_node->next = NULL;
+    if (*head_ref == NULL) {
+        *head_ref = new_node;
+        return;
+    }
+    struct Node* last = *head_ref;
+    while (last->next != NULL) {
+        last = last->next;
+    }
+    last->next = new_node;
+}
+
+static long long sumList(struct Node* node) {
+    long long sum = 0;
+    while (node != NULL) {
+        sum += node->data;
+        node = node->next;
+    }
+    return sum;
+}
+
+// Two lists are built and churned side by side so that a general-purpose
+// allocator interleaves their nodes; each pool keeps its own list together.
+static void benchAllocator(int n) {
+    int churn = 4 * n;
+    double t0, build[2], churnTime[2], traverse[2], destroy[2];
+    long long sums[2];
+
+    // malloc/free
+    struct Node* a = NULL;
+    struct Node* b = NULL;
+    t0 = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        mallocInsertAtBeginning(&a, i);
+        mallocInsertAtBeginning(&b, i);
+    }
+    build[0] = nowSeconds() - t0;
+    t0 = nowSeconds();
+    for (int i = 0; i < churn; i += 64) {
+        for (int k = 0; k < 64; k++) mallocDeleteHead(&a);
+        for (int k = 0; k < 64; k++) mallocInsertAtBeginning(&b, k);
+        for (int k = 0; k < 64; k++) mallocDeleteHead(&b);
+        for (int k = 0; k < 64; k++) mallocInsertAtBeginning(&a, k);
+    }
+    churnTime[0] = nowSeconds() - t0;
+    t0 = nowSeconds();
+    sums[0] = sumList(a) + sumList(b);
+    traverse[0] = nowSeconds() - t0;
+    t0 = nowSeconds();
+    while (a != NULL) mallocDeleteHead(&a);
+    while (b != NULL) mallocDeleteHead(&b);
+    destroy[0] = nowSeconds() - t0;
+
+    // Node pool
+    struct LinkedList la, lb;
+    initList(&la);
+    initList(&lb);
+    t0 = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        insertAtBeginning(&la, i);
+        insertAtBeginning(&lb, i);
+    }
+    build[1] = nowSeconds() - t0;
+    t0 = nowSeconds();
+    for (int i = 0; i < churn; i += 64) {
+        for (int k = 0; k < 64; k++) deleteNode(&la, la.head->data);
+        for (int k = 0; k < 64; k++) insertAtBeginning(&lb, k);
+        for (int k = 0; k < 64; k++) deleteNode(&lb, lb.head->data);
+        for (int k = 0; k < 64; k++) insertAtBeginning(&la, k);
+    }
+    churnTime[1] = nowSeconds() - t0;
+    t0 = nowSeconds();
+    sums[1] = sumList(la.head) + sumList(lb.head);
+    traverse[1] = nowSeconds() - t0;
+    t0 = nowSeconds();
+    list_destroy(&la);
+    list_destroy(&lb);
+    destroy[1] = nowSeconds() - t0;
+
+    if (sums[0] != sums[1]) printf("checksum mismatch\n");
+    printf("2 lists x %d nodes, %d churn ops per list\n", n, churn);
+    printf("%-12s %12s %12s %12s %12s\n", "allocator", "build (s)", "churn (s)", "traverse (s)", "destroy (s)");
+    printf("%-12s %12.4f %12.4f %12.4f %12.4f\n", "malloc", build[0], churnTime[0], traverse[0], destroy[0]);
+    printf("%-12s %12.4f %12.4f %12.4f %12.4f\n", "node pool", build[1], churnTime[1], traverse[1], destroy[1]);
+}
+
+#ifdef NODEPOOL_THREADS
+// Built with -DNODEPOOL_THREADS -pthread: several threads churn private lists
+// whose nodes all come from one shared pool, each through its own PoolCache,
+// against the same churn on malloc/free.
+
+#define MAX_THREADS 64
+
+struct ChurnJob {
+    struct NodePool* pool;  // NULL for malloc/free
+    int nodes;
+    int churn;
+    long long checksum;
+};
+
+static void* runChurn(void* arg) {
+    struct ChurnJob* job = (struct ChurnJob*)arg;
+    struct PoolCache cache;
+    poolCacheInit(&cache, job->pool);  // Unused with malloc/free
     struct Node* head = NULL;
+    for (int i = 0; i < job->nodes + job->churn; i++) {
+        if (i >= job->nodes) {
+            // Past the initial build, every insert is paired with a head delete
+            struct Node* temp = head;
+            head = temp->next;
+            if (job->pool != NULL) poolCacheFree(&cache, temp);
+            else free(temp);
+        }
+        struct Node* node = job->pool != NULL ? (struct Node*)poolCacheAlloc(&cache)
+                                              : (struct Node*)malloc(sizeof(struct Node));
+        if (node == NULL) break;
+        node->data = i;
+        node->next = head;
+        head = node;
+    }
+    job->checksum = sumList(head);
+    while (head != NULL) {
+        struct Node* temp = head;
+        head = temp->next;
+        if (job->pool != NULL) poolCacheFree(&cache, temp);
+        else free(temp);
+    }
+    if (job->pool != NULL) poolCacheFlush(&cache);
+    return NULL;
+}
+
+// Seconds for threads jobs of n nodes and churn insert/delete pairs each
+static double runChurnThreads(struct NodePool* pool, int threads, int n, int churn, long long* checksum) {
+    struct ChurnJob jobs[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    int started[MAX_THREADS];
+    double t0 = nowSeconds();
+    for (int i = 0; i < threads; i++) {
+        jobs[i].pool = pool;
+        jobs[i].nodes = n;
+        jobs[i].churn = churn;
+        jobs[i].checksum = 0;
+        started[i] = pthread_create(&ids[i], NULL, runChurn, &jobs[i]) == 0;
+        if (!started[i]) runChurn(&jobs[i]);
+    }
+    *checksum = 0;
+    for (int i = 0; i < threads; i++) {
+        if (started[i]) pthread_join(ids[i], NULL);
+        *checksum += jobs[i].checksum;
+    }
+    return nowSeconds() - t0;
+}
+
+static void benchThreadedChurn(int n, int maxThreads) {
+    if (maxThreads < 1) maxThreads = 1;
+    if (maxThreads > MAX_THREADS) maxThreads = MAX_THREADS;
+    int churn = 4 * n;
+    printf("\nThreaded churn: %d nodes and %d insert/delete pairs per thread (seconds)\n", n, churn);
+    printf("%-8s %12s %16s\n", "threads", "malloc", "shared pool");
+    for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        long long mallocSum, poolSum;
+        double mallocTime = runChurnThreads(NULL, threads, n, churn, &mallocSum);
+        struct NodePool pool;
+        poolInit(&pool, sizeof(struct Node), POOL_DEFAULT_SLAB_NODES);
+        double poolTime = runChurnThreads(&pool, threads, n, churn, &poolSum);
+        poolDestroy(&pool);
+        if (mallocSum != poolSum) printf("checksum mismatch\n");
+        printf("%-8d %12.4f %16.4f\n", threads, mallocTime, poolTime);
+        if (threads == maxThreads) break;
+    }
+}
+#endif
+
+// Loading records by appending. The walking append is quadratic, so it is
+// only run on a small prefix of the load.
+#define WALKING_APPEND_LIMIT 20000
+
+static void benchAppend(int n) {
+    int walkN = n < WALKING_APPEND_LIMIT ? n : WALKING_APPEND_LIMIT;
+    double t0 = nowSeconds();
+    struct Node* head = NULL;
+    for (int i = 0; i < walkN; i++) walkingInsertAtEnd(&head, i);
+    double walking = nowSeconds() - t0;
+    while (head != NULL) mallocDeleteHead(&head);
+
+    struct LinkedList list;
+    initList(&list);
+    t0 = nowSeconds();
+    for (int i = 0; i < n; i++) insertAtEnd(&list, i);
+    double tailAppend = nowSeconds() - t0;
+    long long appendSum = sumList(list.head);
+    list_destroy(&list);
+
+    int* values = (int*)malloc((size_t)n * sizeof(int));
+    for (int i = 0; i < n; i++) values[i] = i;
+    initList(&list);
+    t0 = nowSeconds();
+    list_from_array(&list, values, n);
+    double fromArray = nowSeconds() - t0;
+    if (sumList(list.head) != appendSum || list.length != n) printf("checksum mismatch\n");
+    list_destroy(&list);
+    free(values);
+
+    printf("\nLoading %d records by appending\n", n);
+    printf("%-20s %12s %14s\n", "method", "elements", "seconds");
+    printf("%-20s %12d %14.4f\n", "walking insertAtEnd", walkN, walking);
+    printf("%-20s %12d %14.4f\n", "tail insertAtEnd", n, tailAppend);
+    printf("%-20s %12d %14.4f\n", "list_from_array", n, fromArray);
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// The previous way of sorting: copy into an array, qsort, write the values back
+static void arraySortList(struct LinkedList* list) {
+    int* values = (int*)malloc((size_t)list->length * sizeof(int));
+    int i = 0;
+    for (struct Node* node = list->head; node != NULL; node = node->next) values[i++] = node->data;
+    qsort(values, (size_t)list->length, sizeof(int), compareInts);
+    i = 0;
+    for (struct Node* node = list->head; node != NULL; node = node->next) node->data = values[i++];
+    free(values);
+}
+
+static int isSorted(struct LinkedList* list) {
+    for (struct Node* node = list->head; node != NULL && node->next != NULL; node = node->next) {
+        if (node->next->data < node->data) return 0;
+    }
+    return 1;
+}
+
+static void benchSort(int n) {
+    const char* names[] = {"random", "nearly sorted", "reversed", "sorted"};
+    int* values = (int*)malloc((size_t)n * sizeof(int));
+    printf("\nSorting %d elements (seconds)\n", n);
+    printf("%-16s %14s %14s\n", "input", "sortList", "array + qsort");
+    for (int pattern = 0; pattern < 4; pattern++) {
+        unsigned int seed = 99;
+        for (int i = 0; i < n; i++) {
+            values[i] = (pattern == 0) ? (int)(nextRandom(&seed) >> 1)
+                      : (pattern == 2) ? n - i : i;
+        }
+        if (pattern == 1) {
+            // Swap 1% of the elements with a random partner
+            for (int k = 0; k < n / 100; k++) {
+                int a = (int)(nextRandom(&seed) % (unsigned int)n);
+                int b = (int)(nextRandom(&seed) % (unsigned int)n);
+                int tmp = values[a];
+                values[a] = values[b];
+                values[b] = tmp;
+            }
+        }
+        struct LinkedList list;
+        initList(&list);
+        list_from_array(&list, values, n);
+        double t0 = nowSeconds();
+        sortList(&list, NULL);
+        double relink = nowSeconds() - t0;
+        if (!isSorted(&list) || list.tail->next != NULL) printf("sortList failed\n");
+        list_destroy(&list);
+
+        initList(&list);
+        list_from_array(&list, values, n);
+        t0 = nowSeconds();
+        arraySortList(&list);
+        double copy = nowSeconds() - t0;
+        list_destroy(&list);
+        printf("%-16s %14.4f %14.4f\n", names[pattern], relink, copy);
+    }
+    free(values);
+}
+
+// Scans cost O(n) each, so only this many are timed
+#define SCAN_OPS 200
+
+// Average and worst latency of searchNode, deleteNode and insertAtEnd with and
+// without the hash index, on a list of n distinct keys in random order
+static void benchIndex(int n) {
+    if (n < 2) return;
+    int* keys = (int*)malloc((size_t)n * sizeof(int));
+    unsigned int seed = 7;
+    for (int i = 0; i < n; i++) keys[i] = 2 * i;  // Odd keys are misses
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(nextRandom(&seed) % (unsigned int)(i + 1));
+        int tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+    int ops = n / 2;
+    double mean[2][4], worst[2];
+    
+    for (int indexed = 0; indexed < 2; indexed++) {
+        struct LinkedList list;
+        initList(&list);
+        if (indexed) list_enable_index(&list);
+        
+        // Build by appending, timing each insert to catch resize spikes
+        double slowest = 0, t0 = nowSeconds();
+        for (int i = 0; i < n; i++) {
+            double start = nowSeconds();
+            insertAtEnd(&list, keys[i]);
+            double elapsed = nowSeconds() - start;
+            if (elapsed > slowest) slowest = elapsed;
+        }
+        mean[indexed][0] = (nowSeconds() - t0) / n;
+        worst[indexed] = slowest;
+        
+        // Targets are spread evenly over the list
+        int count = indexed || ops < SCAN_OPS ? ops : SCAN_OPS;
+        int stride = n / count;
+        int hits = 0, misses = 0;
+        t0 = nowSeconds();
+        for (int i = 0; i < count; i++) hits += searchNode(&list, keys[i * stride]);
+        mean[indexed][1] = (nowSeconds() - t0) / count;
+        t0 = nowSeconds();
+        for (int i = 0; i < count; i++) misses += searchNode(&list, 2 * i + 1);
+        mean[indexed][2] = (nowSeconds() - t0) / count;
+        if (hits != count || misses != 0) printf("search failed\n");
+        t0 = nowSeconds();
+        for (int i = 0; i < count; i++) deleteNode(&list, keys[i * stride]);
+        mean[indexed][3] = (nowSeconds() - t0) / count;
+        if (list.length != n - count || searchNode(&list, keys[0])) printf("delete failed\n");
+        list_destroy(&list);
+    }
+    free(keys);
+    
+    printf("\nKeyed operations on %d nodes (ns per op; scans timed on %d ops)\n", n, SCAN_OPS);
+    printf("%-12s %12s %12s %12s %12s %16s\n", "list", "insertAtEnd", "search hit", "search miss", "deleteNode", "worst insert us");
+    const char* names[] = {"scan", "hash index"};
+    for (int i = 0; i < 2; i++) {
+        printf("%-12s %12.1f %12.1f %12.1f %12.1f %16.2f\n", names[i], mean[i][0] * 1e9, mean[i][1] * 1e9,
+               mean[i][2] * 1e9, mean[i][3] * 1e9, worst[i] * 1e6);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Test: random inserts and deletes with the index on, checked against a count
+// per key. Keys are deleted while the index is still moving slots out of its
+// old table, which is where stale entries would show up.
+// ---------------------------------------------------------------------------
+
+#define TEST_KEYS 512
+
+static int testIndexDuringResize(void) {
+    int expected[TEST_KEYS] = {0};
+    int length = 0, deletesDuringResize = 0;
+    unsigned int seed = 2024;
+    struct LinkedList list;
+    initList(&list);
+    list_enable_index(&list);
+    for (int op = 0; op < 200000 && list.index != NULL; op++) {
+        int key = (int)(nextRandom(&seed) % TEST_KEYS);
+        unsigned int choice = nextRandom(&seed) % 8;
+        if (choice < 3) {
+            insertAtEnd(&list, key);
+        } else if (choice < 5) {
+            insertAtBeginning(&list, key);
+        } else if (choice < 6) {
+            insertAtPosition(&list, key, (int)(nextRandom(&seed) % (unsigned int)(list.length + 1)));
+        } else {
+            if (list.index->old != NULL && expected[key] > 0) deletesDuringResize++;
+            deleteNode(&list, key);
+            if (expected[key] > 0) {
+                expected[key]--;
+                length--;
+            }
+            if (searchNode(&list, key) != (expected[key] > 0)) {
+                printf("FAIL: key %d after delete at op %d\n", key, op);
+                list_destroy(&list);
+                return -1;
+            }
+            continue;
+        }
+        expected[key]++;
+        length++;
+        // Empty the list now and then so the index keeps growing from small sizes
+        if (length > 4 * TEST_KEYS) {
+            list_destroy(&list);
+            initList(&list);
+            list_enable_index(&list);
+            memset(expected, 0, sizeof(expected));
+            length = 0;
+        }
+    }
+    int linked = 0;
+    for (struct Node* node = list.head; node != NULL; node = node->next) linked++;
+    int failed = list.index == NULL || linked != length || list.length != length;
+    for (int key = 0; key < TEST_KEYS && !failed; key++) failed = searchNode(&list, key) != (expected[key] > 0);
+    list_destroy(&list);
+    if (failed || deletesDuringResize == 0) {
+        printf("FAIL: index out of step with the list\n");
+        return -1;
+    }
+    printf("Index test passed (%d deletes during a resize)\n", deletesDuringResize);
+    return 0;
+}
+
+// Sort in descending order, used to show a custom comparator
+static int descending(int a, int b) {
+    return (b > a) - (b < a);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--test") == 0) {
+        return testIndexDuringResize() == 0 ? 0 : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchAllocator(argc > 2 ? atoi(argv[2]) : 1000000);
+        benchAppend(argc > 3 ? atoi(argv[3]) : 10000000);
+        benchSort(argc > 4 ? atoi(argv[4]) : 1000000);
+        benchIndex(argc > 5 ? atoi(argv[5]) : 1000000);
+#ifdef NODEPOOL_THREADS
+        benchThreadedChurn(argc > 2 ? atoi(argv[2]) : 1000000, argc > 6 ? atoi(argv[6]) : 4);
+#endif
+        return 0;
+    }
+
+    // Initialize an empty linked list
+    struct LinkedList list;
+    initList(&list);
     
     // Insert nodes
-    insertAtEnd(&head, 1);
-    insertAtBeginning(&head, 2);
-    insertAtEnd(&head, 3);
-    insertAtPosition(&head, 4, 1);
+    insertAtEnd(&list, 1);
+    insertAtBeginning(&list, 2);
+    insertAtEnd(&list, 3);
+    insertAtPosition(&list, 4, 1);
+    if (insertAtPosition(&list, 5, 10) != 0) {
+        printf("Position 10 is past the end of the list (length %d).\n", list.length);
+    }
     
     // Print the list
     printf("Linked list after insertion: ");
-    printList(head);
+    printList(&list);
     
     // Delete a node
-    deleteNode(&head, 2);
+    deleteNode(&list, 2);
     
     // Print the list after deletion
     printf("Linked list after deletion: ");
-    printList(head);
+    printList(&list);
     
     // Search for a node
     int key = 3;
-    if (searchNode(head, key)) {
+    if (searchNode(&list, key)) {
         printf("%d is found in the list.\n", key);
     } else {
         printf("%d is not found in the list.\n", key);
     }
     
     // Reverse the list
-    reverseList(&head);
+    reverseList(&list);
     
     // Print the reversed list
     printf("Linked list after reversal: ");
-    printList(head);
+    printList(&list);
+    
+    // Free all nodes at once
+    list_destroy(&list);
+    
+    // Build a list from an array in one pass
+    int values[] = {5, 6, 7, 8};
+    initList(&list);
+    list_from_array(&list, values, 4);
+    insertAtEnd(&list, 9);
+    printf("Linked list built from an array: ");
+    printList(&list);
+    list_destroy(&list);
+    
+    // Sort a list by relinking its nodes
+    int unsorted[] = {7, 3, 9, 1, 3, 8, 2};
+    initList(&list);
+    list_from_array(&list, unsorted, 7);
+    sortList(&list, NULL);
+    printf("Linked list after sorting: ");
+    printList(&list);
+    sortList(&list, descending);
+    printf("Linked list sorted in descending order: ");
+    printList(&list);
+    
+    // Keyed lookups and deletes through the hash index
+    list_enable_index(&list);
+    deleteNode(&list, 3);
+    printf("Linked list after deleting 3 through the index: ");
+    printList(&list);
+    printf("3 is %sin the list, 4 is %sin the list.\n", searchNode(&list, 3) ? "" : "not ",
+           searchNode(&list, 4) ? "" : "not ");
+    list_destroy(&list);
     
     return 0;
-}
\ No newline at end of file
+}
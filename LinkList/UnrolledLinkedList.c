@@ -0,0 +1,409 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "NodePool.h"
+
+// Unrolled linked list: every node stores a small array of ints instead of a
+// single int, so a traversal touches one cache line per BLOCK_CAPACITY elements
+// instead of one per element. The API matches
+// TraversalInsertionDeletionSearchingSorting.c.
+
+#define CACHE_LINE 64
+// As many ints as fit in one cache line next to the link and the count
+#define BLOCK_CAPACITY ((CACHE_LINE - sizeof(void*) - sizeof(int)) / sizeof(int))
+
+// Define the structure for a block in the unrolled list
+struct Block {
+    struct Block* next;         // Pointer to the next block
+    int count;                  // Number of used entries in data
+    int data[BLOCK_CAPACITY];   // Elements, kept in list order
+};
+
+// The list owns the pool its blocks are allocated from
+struct UnrolledList {
+    struct Block* head;
+    struct NodePool pool;
+};
+
+// Initialize an empty unrolled list
+void initList(struct UnrolledList* list) {
+    list->head = NULL;
+    poolInit(&list->pool, sizeof(struct Block), POOL_DEFAULT_SLAB_NODES);
+}
+
+// Free every block of the list at once by releasing the pool's slabs
+void list_destroy(struct UnrolledList* list) {
+    poolDestroy(&list->pool);
+    list->head = NULL;
+}
+
+// Allocate an empty block that will be linked in front of `next`
+static struct Block* newBlock(struct UnrolledList* list, struct Block* next) {
+    struct Block* block = (struct Block*)poolAlloc(&list->pool);
+    if (block == NULL) return NULL;
+    block->next = next;
+    block->count = 0;
+    return block;
+}
+
+// Move the upper half of a full block into a new block linked after it
+static struct Block* splitBlock(struct UnrolledList* list, struct Block* block) {
+    struct Block* upper = newBlock(list, block->next);
+    if (upper == NULL) return NULL;
+    int half = block->count / 2;
+    upper->count = block->count - half;
+    memcpy(upper->data, block->data + half, upper->count * sizeof(int));
+    block->count = half;
+    block->next = upper;
+    return upper;
+}
+
+// Function to insert an element at the beginning of the list (O(1))
+void insertAtBeginning(struct UnrolledList* list, int new_data) {
+    struct Block* head = list->head;
+
+    // Start a new block when the first one is full
+    if (head == NULL || head->count == (int)BLOCK_CAPACITY) {
+        head = newBlock(list, list->head);
+        if (head == NULL) return;
+        list->head = head;
+    }
+
+    // Shift the (at most BLOCK_CAPACITY) elements of the first block right by one
+    memmove(head->data + 1, head->data, head->count * sizeof(int));
+    head->data[0] = new_data;
+    head->count++;
+}
+
+// Function to insert an element at the end of the list
+void insertAtEnd(struct UnrolledList* list, int new_data) {
+    // If the list is empty, start the first block
+    if (list->head == NULL) {
+        list->head = newBlock(list, NULL);
+        if (list->head == NULL) return;
+    }
+
+    // Traverse to the last block (one hop per block, not per element)
+    struct Block* last = list->head;
+    while (last->next != NULL) {
+        last = last->next;
+    }
+
+    if (last->count == (int)BLOCK_CAPACITY) {
+        last->next = newBlock(list, NULL);
+        if (last->next == NULL) return;
+        last = last->next;
+    }
+    last->data[last->count++] = new_data;
+}
+
+// Function to insert an element at a specific position in the list
+void insertAtPosition(struct UnrolledList* list, int new_data, int position) {
+    // A negative position is out of bounds, do nothing
+    if (position < 0) return;
+
+    if (position == 0) {
+        insertAtBeginning(list, new_data);
+        return;
+    }
+
+    // Find the block holding the position; position == count of a block means "append to it"
+    struct Block* current = list->head;
+    while (current != NULL && position > current->count) {
+        position -= current->count;
+        current = current->next;
+    }
+
+    // If the position is out of bounds, do nothing
+    if (current == NULL) return;
+
+    // A full block is split in two, then the insert goes into the half that owns the position
+    if (current->count == (int)BLOCK_CAPACITY) {
+        struct Block* upper = splitBlock(list, current);
+        if (upper == NULL) return;
+        if (position > current->count) {
+            position -= current->count;
+            current = upper;
+        }
+    }
+
+    memmove(current->data + position + 1, current->data + position,
+            (current->count - position) * sizeof(int));
+    current->data[position] = new_data;
+    current->count++;
+}
+
+// Function to delete the first element with a given value from the list
+void deleteNode(struct UnrolledList* list, int key) {
+    struct Block* current = list->head;
+    struct Block* prev = NULL;
+    int index = -1;
+
+    // Search for the key to be deleted, keep track of the previous block
+    while (current != NULL) {
+        for (int i = 0; i < current->count; i++) {
+            if (current->data[i] == key) {
+                index = i;
+                break;
+            }
+        }
+        if (index >= 0) break;
+        prev = current;
+        current = current->next;
+    }
+
+    // If the key was not present in the list
+    if (current == NULL) return;
+
+    // Close the gap inside the block
+    current->count--;
+    memmove(current->data + index, current->data + index + 1,
+            (current->count - index) * sizeof(int));
+
+    // An empty block is unlinked and returned to the pool
+    if (current->count == 0) {
+        if (prev == NULL) {
+            list->head = current->next;
+        } else {
+            prev->next = current->next;
+        }
+        poolFree(&list->pool, current);
+        return;
+    }
+
+    // Keep blocks at least half full so traversal stays dense
+    struct Block* next = current->next;
+    if (current->count < (int)BLOCK_CAPACITY / 2 && next != NULL) {
+        if (current->count + next->count <= (int)BLOCK_CAPACITY) {
+            // Merge the next block into this one
+            memcpy(current->data + current->count, next->data, next->count * sizeof(int));
+            current->count += next->count;
+            current->next = next->next;
+            poolFree(&list->pool, next);
+        } else {
+            // Borrow elements from the front of the next block
+            int moved = (int)BLOCK_CAPACITY / 2 - current->count;
+            memcpy(current->data + current->count, next->data, moved * sizeof(int));
+            current->count += moved;
+            next->count -= moved;
+            memmove(next->data, next->data + moved, next->count * sizeof(int));
+        }
+    }
+}
+
+// Scan one block without an early exit so the compiler can vectorize the comparison
+static int blockContains(const struct Block* block, int key) {
+    int found = 0;
+    for (int i = 0; i < block->count; i++) {
+        found |= (block->data[i] == key);
+    }
+    return found;
+}
+
+// Function to search for an element with a given value in the list
+int searchNode(struct UnrolledList* list, int key) {
+    // Traverse the list one block at a time
+    for (struct Block* current = list->head; current != NULL; current = current->next) {
+        if (blockContains(current, key)) {
+            return 1; // Found
+        }
+    }
+    return 0; // Not found
+}
+
+// Function to traverse and print the list
+void printList(struct UnrolledList* list) {
+    for (struct Block* block = list->head; block != NULL; block = block->next) {
+        for (int i = 0; i < block->count; i++) {
+            printf("%d -> ", block->data[i]);
+        }
+    }
+    printf("NULL\n");
+}
+
+// Function to reverse the list: reverse the block order and each block's contents
+void reverseList(struct UnrolledList* list) {
+    struct Block* prev = NULL;
+    struct Block* current = list->head;
+    struct Block* next = NULL;
+
+    while (current != NULL) {
+        for (int i = 0, j = current->count - 1; i < j; i++, j--) {
+            int tmp = current->data[i];
+            current->data[i] = current->data[j];
+            current->data[j] = tmp;
+        }
+        next = current->next;
+        current->next = prev;
+        prev = current;
+        current = next;
+    }
+
+    list->head = prev;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: traversal and search against one node per element
+// ---------------------------------------------------------------------------
+
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static long long sumNodes(struct Node* node) {
+    long long sum = 0;
+    for (; node != NULL; node = node->next) sum += node->data;
+    return sum;
+}
+
+static int searchNodes(struct Node* node, int key) {
+    for (; node != NULL; node = node->next) {
+        if (node->data == key) return 1;
+    }
+    return 0;
+}
+
+static long long sumBlocks(struct UnrolledList* list) {
+    long long sum = 0;
+    for (struct Block* block = list->head; block != NULL; block = block->next) {
+        for (int i = 0; i < block->count; i++) sum += block->data[i];
+    }
+    return sum;
+}
+
+// Link nodes[0..n) into a list holding 0..n-1 in the memory order given by order[]
+static struct Node* linkNodes(struct Node* nodes, const int* order, int n) {
+    struct Node* head = NULL;
+    for (int i = n - 1; i >= 0; i--) {
+        struct Node* node = &nodes[order[i]];
+        node->data = i;
+        node->next = head;
+        head = node;
+    }
+    return head;
+}
+
+// Builds lists holding 0..n-1 in each layout. The node-per-element list is
+// measured twice: with nodes contiguous in list order, as the unrolled list's
+// blocks are, and linked in shuffled memory order, like a list that has been
+// through heavy insert/delete churn on a general-purpose heap.
+static void runBenchmark(int n, int searches) {
+    struct Node* nodes = (struct Node*)malloc((size_t)n * sizeof(struct Node));
+    int* order = (int*)malloc((size_t)n * sizeof(int));
+    unsigned int seed = 2024;
+    for (int i = 0; i < n; i++) order[i] = i;
+
+    struct UnrolledList list;
+    initList(&list);
+    for (int i = n - 1; i >= 0; i--) insertAtBeginning(&list, i);
+
+    printf("%d elements, %d searches, %d ints per block\n", n, searches, (int)BLOCK_CAPACITY);
+    printf("%-18s %16s %16s %14s\n", "layout", "traverse (ns/el)", "search (ms/op)", "bytes/element");
+    const char* names[] = {"nodes, sequential", "nodes, shuffled"};
+    int nodeHits = 0;
+    for (int layout = 0; layout < 2; layout++) {
+        if (layout == 1) {
+            for (int i = n - 1; i > 0; i--) {
+                int j = (int)(nextRandom(&seed) % (unsigned int)(i + 1));
+                int tmp = order[i];
+                order[i] = order[j];
+                order[j] = tmp;
+            }
+        }
+        struct Node* head = linkNodes(nodes, order, n);
+
+        double t0 = nowSeconds();
+        long long nodeSum = sumNodes(head);
+        double nodeTraverse = nowSeconds() - t0;
+        if (nodeSum != sumBlocks(&list)) printf("checksum mismatch\n");
+
+        // Half of the keys exist (uniform position), half are missing
+        nodeHits = 0;
+        unsigned int keySeed = 7;
+        t0 = nowSeconds();
+        for (int i = 0; i < searches; i++) {
+            int key = (int)(nextRandom(&keySeed) % (unsigned int)(2 * n));
+            nodeHits += searchNodes(head, key);
+        }
+        double nodeSearch = nowSeconds() - t0;
+        printf("%-18s %16.2f %16.3f %14.1f\n", names[layout], nodeTraverse * 1e9 / n,
+               nodeSearch * 1e3 / searches, (double)sizeof(struct Node));
+    }
+
+    double t0 = nowSeconds();
+    long long blockSum = sumBlocks(&list);
+    double blockTraverse = nowSeconds() - t0;
+    int blockHits = 0;
+    unsigned int keySeed = 7;
+    t0 = nowSeconds();
+    for (int i = 0; i < searches; i++) {
+        int key = (int)(nextRandom(&keySeed) % (unsigned int)(2 * n));
+        blockHits += searchNode(&list, key);
+    }
+    double blockSearch = nowSeconds() - t0;
+    if (blockSum != (long long)n * (n - 1) / 2) printf("checksum mismatch\n");
+    if (nodeHits != blockHits) printf("search mismatch\n");
+    printf("%-18s %16.2f %16.3f %14.1f\n", "unrolled blocks", blockTraverse * 1e9 / n,
+           blockSearch * 1e3 / searches, (double)sizeof(struct Block) / BLOCK_CAPACITY);
+
+    list_destroy(&list);
+    free(nodes);
+    free(order);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 4000000, 50);
+        return 0;
+    }
+
+    // Initialize an empty list
+    struct UnrolledList list;
+    initList(&list);
+
+    // Insert enough elements to fill several blocks
+    for (int i = 1; i <= 30; i++) {
+        insertAtEnd(&list, i);
+    }
+    insertAtBeginning(&list, 0);
+    insertAtPosition(&list, 100, 5);  // Splits the first block
+
+    printf("Unrolled list after insertion: ");
+    printList(&list);
+
+    // Delete elements, blocks merge when they fall below half full
+    for (int i = 1; i <= 12; i++) {
+        deleteNode(&list, i);
+    }
+    printf("Unrolled list after deletion: ");
+    printList(&list);
+
+    int key = 20;
+    if (searchNode(&list, key)) {
+        printf("%d is found in the list.\n", key);
+    } else {
+        printf("%d is not found in the list.\n", key);
+    }
+
+    reverseList(&list);
+    printf("Unrolled list after reversal: ");
+    printList(&list);
+
+    list_destroy(&list);
+    return 0;
+}
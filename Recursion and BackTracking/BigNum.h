@@ -0,0 +1,340 @@
+#ifndef BIG_NUM_H
+#define BIG_NUM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Arbitrary-precision unsigned integers shared by fibonachisequence.c and
+// factorial.c.
+//
+// A number is an array of 32-bit limbs, least significant first, with no
+// leading zero limbs (zero has length 0). Limb products fit in uint64_t, so
+// no compiler-specific 128-bit type is needed. Large products use Karatsuba
+// multiplication: three half-size products instead of four, about
+// O(n^1.58) instead of O(n^2).
+//
+// Functions that allocate return 0 on success and -1 when out of memory.
+// The result argument may be the same number as an operand.
+
+#define BIG_KARATSUBA_THRESHOLD 40  // Below this many limbs schoolbook multiplication is faster
+
+struct BigNum {
+    uint32_t* limbs;
+    size_t length;     // Limbs in use
+    size_t capacity;
+};
+
+static inline void bigInit(struct BigNum* a) {
+    a->limbs = NULL;
+    a->length = 0;
+    a->capacity = 0;
+}
+
+static inline void bigFree(struct BigNum* a) {
+    free(a->limbs);
+    bigInit(a);
+}
+
+static inline int bigReserve(struct BigNum* a, size_t capacity) {
+    if (capacity <= a->capacity) return 0;
+    uint32_t* limbs = (uint32_t*)realloc(a->limbs, capacity * sizeof(uint32_t));
+    if (limbs == NULL) return -1;
+    a->limbs = limbs;
+    a->capacity = capacity;
+    return 0;
+}
+
+// Drop leading zero limbs
+static inline void bigTrim(struct BigNum* a) {
+    while (a->length > 0 && a->limbs[a->length - 1] == 0) {
+        a->length--;
+    }
+}
+
+static inline int bigSetU64(struct BigNum* a, uint64_t value) {
+    if (bigReserve(a, 2) != 0) return -1;
+    a->limbs[0] = (uint32_t)value;
+    a->limbs[1] = (uint32_t)(value >> 32);
+    a->length = 2;
+    bigTrim(a);
+    return 0;
+}
+
+static inline int bigCopy(struct BigNum* r, const struct BigNum* a) {
+    if (r == a) return 0;
+    if (bigReserve(r, a->length) != 0) return -1;
+    memcpy(r->limbs, a->limbs, a->length * sizeof(uint32_t));
+    r->length = a->length;
+    return 0;
+}
+
+static inline void bigSwap(struct BigNum* a, struct BigNum* b) {
+    struct BigNum t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static inline size_t bigBitLength(const struct BigNum* a) {
+    if (a->length == 0) return 0;
+    uint32_t top = a->limbs[a->length - 1];
+    size_t bits = 0;
+    while (top != 0) {
+        bits++;
+        top >>= 1;
+    }
+    return (a->length - 1) * 32 + bits;
+}
+
+// r[0..rn) += a[0..an) with an <= rn; returns the carry out of r
+static inline uint32_t bigAddRaw(uint32_t* r, size_t rn, const uint32_t* a, size_t an) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < an; i++) {
+        uint64_t t = (uint64_t)r[i] + a[i] + carry;
+        r[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    for (; carry != 0 && i < rn; i++) {
+        uint64_t t = (uint64_t)r[i] + carry;
+        r[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    return (uint32_t)carry;
+}
+
+// r[0..rn) -= a[0..an) with an <= rn; r must not be smaller than a
+static inline void bigSubRaw(uint32_t* r, size_t rn, const uint32_t* a, size_t an) {
+    uint64_t borrow = 0;
+    size_t i = 0;
+    for (; i < an; i++) {
+        uint64_t t = (uint64_t)r[i] - a[i] - borrow;
+        r[i] = (uint32_t)t;
+        borrow = t >> 63;
+    }
+    for (; borrow != 0 && i < rn; i++) {
+        uint64_t t = (uint64_t)r[i] - borrow;
+        r[i] = (uint32_t)t;
+        borrow = t >> 63;
+    }
+}
+
+// out[0..na + nb) = a * b, schoolbook
+static inline void bigMulSchool(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    memset(out, 0, (na + nb) * sizeof(uint32_t));
+    for (size_t i = 0; i < nb; i++) {
+        uint64_t bi = b[i];
+        uint64_t carry = 0;
+        if (bi == 0) continue;
+        for (size_t j = 0; j < na; j++) {
+            uint64_t t = a[j] * bi + out[i + j] + carry;
+            out[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        out[i + na] = (uint32_t)carry;
+    }
+}
+
+// out[0..na + nb) = a * b. out must not overlap a or b.
+static inline int bigMulRaw(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    if (na < nb) {
+        const uint32_t* t = a; a = b; b = t;
+        size_t tn = na; na = nb; nb = tn;
+    }
+    if (nb < BIG_KARATSUBA_THRESHOLD) {
+        bigMulSchool(a, na, b, nb, out);
+        return 0;
+    }
+
+    if (na >= 2 * nb) {
+        // Very different sizes: multiply b by nb-limb slices of a
+        uint32_t* part = (uint32_t*)malloc(2 * nb * sizeof(uint32_t));
+        if (part == NULL) return -1;
+        memset(out, 0, (na + nb) * sizeof(uint32_t));
+        for (size_t i = 0; i < na; i += nb) {
+            size_t len = na - i < nb ? na - i : nb;
+            if (bigMulRaw(a + i, len, b, nb, part) != 0) {
+                free(part);
+                return -1;
+            }
+            bigAddRaw(out + i, na + nb - i, part, len + nb);
+        }
+        free(part);
+        return 0;
+    }
+
+    // Karatsuba: with a = a1 B^m + a0 and b = b1 B^m + b0,
+    // a * b = z2 B^2m + (z1 - z2 - z0) B^m + z0, where z0 = a0 b0,
+    // z2 = a1 b1 and z1 = (a0 + a1)(b0 + b1)
+    size_t m = na / 2;  // nb > na / 2, so b1 is not empty
+    size_t la = na - m + 1;
+    size_t lb = (nb - m > m ? nb - m : m) + 1;
+    uint32_t* buffer = (uint32_t*)malloc(2 * (la + lb) * sizeof(uint32_t));
+    if (buffer == NULL) return -1;
+    uint32_t* sa = buffer;
+    uint32_t* sb = sa + la;
+    uint32_t* z1 = sb + lb;
+
+    memcpy(sa, a + m, (na - m) * sizeof(uint32_t));
+    sa[na - m] = 0;
+    bigAddRaw(sa, la, a, m);
+    if (nb - m > m) {
+        memcpy(sb, b + m, (nb - m) * sizeof(uint32_t));
+        sb[nb - m] = 0;
+        bigAddRaw(sb, lb, b, m);
+    } else {
+        memcpy(sb, b, m * sizeof(uint32_t));
+        sb[m] = 0;
+        bigAddRaw(sb, lb, b + m, nb - m);
+    }
+
+    // z0 and z2 go straight into the low and high parts of out
+    if (bigMulRaw(a, m, b, m, out) != 0 ||
+        bigMulRaw(a + m, na - m, b + m, nb - m, out + 2 * m) != 0 ||
+        bigMulRaw(sa, la, sb, lb, z1) != 0) {
+        free(buffer);
+        return -1;
+    }
+    bigSubRaw(z1, la + lb, out, 2 * m);
+    bigSubRaw(z1, la + lb, out + 2 * m, na + nb - 2 * m);
+    size_t lz = la + lb;
+    while (lz > 0 && z1[lz - 1] == 0) lz--;
+    bigAddRaw(out + m, na + nb - m, z1, lz);
+    free(buffer);
+    return 0;
+}
+
+// r = a + b
+static inline int bigAdd(struct BigNum* r, const struct BigNum* a, const struct BigNum* b) {
+    size_t na = a->length, nb = b->length;
+    size_t n = (na > nb ? na : nb) + 1;
+    if (bigReserve(r, n) != 0) return -1;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t = carry;
+        if (i < na) t += a->limbs[i];
+        if (i < nb) t += b->limbs[i];
+        r->limbs[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    r->length = n;
+    bigTrim(r);
+    return 0;
+}
+
+// r = a - b, where a >= b
+static inline int bigSub(struct BigNum* r, const struct BigNum* a, const struct BigNum* b) {
+    size_t na = a->length, nb = b->length;
+    if (bigReserve(r, na) != 0) return -1;
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < na; i++) {
+        uint64_t t = (uint64_t)a->limbs[i] - (i < nb ? b->limbs[i] : 0) - borrow;
+        r->limbs[i] = (uint32_t)t;
+        borrow = t >> 63;
+    }
+    r->length = na;
+    bigTrim(r);
+    return 0;
+}
+
+// r = a * b
+static inline int bigMul(struct BigNum* r, const struct BigNum* a, const struct BigNum* b) {
+    if (a->length == 0 || b->length == 0) {
+        r->length = 0;
+        return 0;
+    }
+    size_t n = a->length + b->length;
+    uint32_t* out = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (out == NULL || bigMulRaw(a->limbs, a->length, b->limbs, b->length, out) != 0) {
+        free(out);
+        return -1;
+    }
+    free(r->limbs);
+    r->limbs = out;
+    r->length = n;
+    r->capacity = n;
+    bigTrim(r);
+    return 0;
+}
+
+// r = r * m for a single-limb m
+static inline int bigMulSmall(struct BigNum* r, uint32_t m) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < r->length; i++) {
+        uint64_t t = (uint64_t)r->limbs[i] * m + carry;
+        r->limbs[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    if (carry != 0) {
+        // Grow geometrically so that repeated calls stay amortized O(length)
+        if (r->length == r->capacity && bigReserve(r, 2 * r->capacity + 1) != 0) return -1;
+        r->limbs[r->length++] = (uint32_t)carry;
+    }
+    return 0;
+}
+
+// r = a << bits
+static inline int bigShiftLeft(struct BigNum* r, const struct BigNum* a, size_t bits) {
+    if (a->length == 0) {
+        r->length = 0;
+        return 0;
+    }
+    size_t words = bits / 32;
+    unsigned shift = (unsigned)(bits % 32);
+    size_t na = a->length;
+    if (bigReserve(r, na + words + 1) != 0) return -1;
+    // Work from the top down so that r may be a
+    r->limbs[na + words] = shift ? a->limbs[na - 1] >> (32 - shift) : 0;
+    for (size_t i = na; i-- > 0;) {
+        uint32_t low = (shift && i > 0) ? a->limbs[i - 1] >> (32 - shift) : 0;
+        r->limbs[i + words] = (a->limbs[i] << shift) | low;
+    }
+    memset(r->limbs, 0, words * sizeof(uint32_t));
+    r->length = na + words + 1;
+    bigTrim(r);
+    return 0;
+}
+
+// Decimal digits of a as a malloc'd string (the caller frees it), or NULL when
+// out of memory. Repeated division by 10^9 makes this O(n^2): fine for
+// printing, but not part of the fast paths.
+static inline char* bigToDecimal(const struct BigNum* a) {
+    size_t n = a->length;
+    size_t chunks = n * 32 / 29 + 2;  // 10^9 > 2^29, so each chunk takes at least 29 bits
+    uint32_t* work = (uint32_t*)malloc((n + 1) * sizeof(uint32_t));
+    uint32_t* parts = (uint32_t*)malloc(chunks * sizeof(uint32_t));
+    char* text = (char*)malloc(chunks * 9 + 2);
+    if (work == NULL || parts == NULL || text == NULL) {
+        free(work); free(parts); free(text);
+        return NULL;
+    }
+    memcpy(work, a->limbs, n * sizeof(uint32_t));
+    size_t count = 0;
+    while (n > 0) {
+        uint64_t rem = 0;
+        for (size_t i = n; i-- > 0;) {
+            uint64_t cur = (rem << 32) | work[i];
+            work[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        parts[count++] = (uint32_t)rem;
+        while (n > 0 && work[n - 1] == 0) n--;
+    }
+    char* p = text;
+    if (count == 0) {
+        *p++ = '0';
+    } else {
+        p += sprintf(p, "%u", parts[count - 1]);
+        for (size_t i = count - 1; i-- > 0;) {
+            p += sprintf(p, "%09u", parts[i]);
+        }
+    }
+    *p = '\0';
+    free(work);
+    free(parts);
+    return text;
+}
+
+#endif  // BIG_NUM_H
@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// Binary search without recursion or branches, over a sorted array stored in
+// Eytzinger (breadth-first) order.
+//
+// BinarySearchUsingRecursion.py halves the range with a recursive call and an
+// if/else per step. On a large table each step is a cache miss the CPU
+// cannot start early, because the next address depends on a branch it has to
+// guess. Here the sorted keys are rearranged as an implicit binary tree: the
+// root is keys[1] and the children of keys[k] are keys[2k] and keys[2k + 1].
+// A search then descends with k = 2k + (keys[k] < x), which compiles to a
+// conditional move. The 16 descendants four levels below k share one cache
+// line, so they are prefetched while the current level is compared.
+
+#define CACHE_LINE 64
+#define KEYS_PER_LINE (CACHE_LINE / sizeof(int))
+#define BATCH_WIDTH 16  // Lookups search_many keeps in flight at once
+
+struct EytzingerIndex {
+    int* keys;      // keys[1..n] in Eytzinger order, keys[0] unused
+    int* ranks;     // ranks[k]: position of keys[k] in the sorted array
+    size_t n;
+};
+
+// Rearrange sorted[0..n) into Eytzinger order with an in-order walk of the
+// implicit tree: the i-th node visited in order receives sorted[i].
+// Returns 0, or -1 if out of memory.
+int eytzinger_build(struct EytzingerIndex* index, const int* sorted, size_t n) {
+    // Aligned so that keys[16k..16k + 15] is exactly one cache line
+    size_t bytes = ((n + 1) * sizeof(int) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    index->keys = (int*)aligned_alloc(CACHE_LINE, bytes);
+    index->ranks = (int*)malloc((n + 1) * sizeof(int));
+    index->n = n;
+    if (index->keys == NULL || index->ranks == NULL) {
+        free(index->keys);
+        free(index->ranks);
+        return -1;
+    }
+    index->keys[0] = 0;
+    index->ranks[0] = (int)n;  // Lets a failed descent (k == 0) map to rank n
+
+    // Start at the leftmost node
+    size_t k = 1;
+    while (2 * k <= n) k = 2 * k;
+    for (size_t i = 0; i < n; i++) {
+        index->keys[k] = sorted[i];
+        index->ranks[k] = (int)i;
+        // In-order successor: the leftmost node of the right subtree if there
+        // is one, else the nearest ancestor whose left subtree just finished
+        if (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+            while (2 * k <= n) k = 2 * k;
+        } else {
+            while (k & 1) k >>= 1;
+            k >>= 1;
+        }
+    }
+    return 0;
+}
+
+void eytzinger_destroy(struct EytzingerIndex* index) {
+    free(index->keys);
+    free(index->ranks);
+    index->keys = NULL;
+    index->ranks = NULL;
+    index->n = 0;
+}
+
+// After the descent, k encodes the path taken (a 1 bit for every right turn).
+// The answer is the last node where the path turned left: strip the trailing
+// right turns and that left turn.
+static inline size_t lastLeftTurn(size_t k) {
+    return k >> __builtin_ffsl((long)~k);
+}
+
+// Position of the first key >= x in the sorted array, or n if there is none
+size_t eytzinger_lower_bound(const struct EytzingerIndex* index, int x) {
+    const int* keys = index->keys;
+    size_t k = 1;
+    while (k <= index->n) {
+        __builtin_prefetch(keys + KEYS_PER_LINE * k);
+        k = 2 * k + (keys[k] < x);
+    }
+    return (size_t)index->ranks[lastLeftTurn(k)];
+}
+
+// Position of the first key > x in the sorted array, or n if there is none
+size_t eytzinger_upper_bound(const struct EytzingerIndex* index, int x) {
+    const int* keys = index->keys;
+    size_t k = 1;
+    while (k <= index->n) {
+        __builtin_prefetch(keys + KEYS_PER_LINE * k);
+        k = 2 * k + (keys[k] <= x);
+    }
+    return (size_t)index->ranks[lastLeftTurn(k)];
+}
+
+// Position of x in the sorted array, or -1 if it is not present
+long eytzinger_search(const struct EytzingerIndex* index, int x) {
+    const int* keys = index->keys;
+    size_t k = 1;
+    while (k <= index->n) {
+        __builtin_prefetch(keys + KEYS_PER_LINE * k);
+        k = 2 * k + (keys[k] < x);
+    }
+    k = lastLeftTurn(k);
+    return (k != 0 && keys[k] == x) ? index->ranks[k] : -1;
+}
+
+// Lower bounds for a batch of lookups. BATCH_WIDTH descents advance one level
+// at a time in lockstep, so up to BATCH_WIDTH cache misses are outstanding at
+// once instead of one.
+static void descend_many(const struct EytzingerIndex* index, const int* xs, size_t count, size_t* nodes) {
+    const int* keys = index->keys;
+    size_t n = index->n;
+
+    // Levels that every descent completes without leaving the tree
+    int fullLevels = 0;
+    while (((size_t)2 << fullLevels) - 1 <= n) fullLevels++;
+
+    for (size_t base = 0; base < count; base += BATCH_WIDTH) {
+        size_t width = count - base < BATCH_WIDTH ? count - base : BATCH_WIDTH;
+        size_t k[BATCH_WIDTH];
+        for (size_t j = 0; j < width; j++) k[j] = 1;
+        for (int level = 0; level < fullLevels; level++) {
+            for (size_t j = 0; j < width; j++) {
+                __builtin_prefetch(keys + KEYS_PER_LINE * k[j]);
+                k[j] = 2 * k[j] + (keys[k[j]] < xs[base + j]);
+            }
+        }
+        // The last, partly filled level
+        for (size_t j = 0; j < width; j++) {
+            if (k[j] <= n) k[j] = 2 * k[j] + (keys[k[j]] < xs[base + j]);
+            nodes[base + j] = lastLeftTurn(k[j]);
+        }
+    }
+}
+
+// Lower bounds of xs[0..count) into results[]
+void lower_bound_many(const struct EytzingerIndex* index, const int* xs, size_t count, size_t* results) {
+    descend_many(index, xs, count, results);
+    for (size_t i = 0; i < count; i++) {
+        results[i] = (size_t)index->ranks[results[i]];
+    }
+}
+
+// Positions of xs[0..count) into results[], -1 where a key is not present
+void search_many(const struct EytzingerIndex* index, const int* xs, size_t count, long* results) {
+    size_t nodes[BATCH_WIDTH];
+    for (size_t base = 0; base < count; base += BATCH_WIDTH) {
+        size_t width = count - base < BATCH_WIDTH ? count - base : BATCH_WIDTH;
+        descend_many(index, xs + base, width, nodes);
+        for (size_t j = 0; j < width; j++) {
+            size_t k = nodes[j];
+            results[base + j] = (k != 0 && index->keys[k] == xs[base + j]) ? index->ranks[k] : -1;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: plain binary search against the Eytzinger layout
+// ---------------------------------------------------------------------------
+
+// The usual iterative binary search over the sorted array (first key >= x)
+static size_t plainLowerBound(const int* sorted, size_t n, int x) {
+    size_t low = 0, high = n;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (sorted[mid] < x) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void runBenchmark(size_t n, size_t lookups) {
+    struct EytzingerIndex index;
+    int* sorted = (int*)malloc(n * sizeof(int));
+    int* xs = (int*)malloc(lookups * sizeof(int));
+    size_t* results = (size_t*)malloc(lookups * sizeof(size_t));
+    if (sorted == NULL || xs == NULL || results == NULL) {
+        printf("%12zu skipped: not enough memory\n", n);
+        free(sorted); free(xs); free(results);
+        return;
+    }
+
+    // Even keys, so half the lookups (the odd ones) miss
+    for (size_t i = 0; i < n; i++) sorted[i] = (int)(2 * i);
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < lookups; i++) xs[i] = (int)(nextRandom(&seed) % (2 * n));
+    if (eytzinger_build(&index, sorted, n) != 0) {
+        printf("%12zu skipped: not enough memory\n", n);
+        free(sorted); free(xs); free(results);
+        return;
+    }
+
+    size_t checksum = 0;
+    double t0 = nowSeconds();
+    for (size_t i = 0; i < lookups; i++) checksum += plainLowerBound(sorted, n, xs[i]);
+    double plain = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (size_t i = 0; i < lookups; i++) checksum -= eytzinger_lower_bound(&index, xs[i]);
+    double single = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    lower_bound_many(&index, xs, lookups, results);
+    double batch = nowSeconds() - t0;
+    for (size_t i = 0; i < lookups; i++) checksum += results[i] - plainLowerBound(sorted, n, xs[i]);
+
+    if (checksum != 0) printf("results differ from plain binary search\n");
+    printf("%12zu %10.1f MB %14.1f %14.1f %14.1f\n", n, n * sizeof(int) / 1e6,
+           plain * 1e9 / lookups, single * 1e9 / lookups, batch * 1e9 / lookups);
+
+    eytzinger_destroy(&index);
+    free(sorted); free(xs); free(results);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [maxBytes]: array sizes from 16 KB (fits in L1) up to 1 GB
+        size_t maxBytes = argc > 2 ? (size_t)atoll(argv[2]) : ((size_t)1 << 30);
+        size_t lookups = 4000000;
+        printf("%12s %13s %14s %14s %14s\n", "keys", "size", "plain ns", "eytzinger ns", "batched ns");
+        for (size_t bytes = (size_t)16 << 10; bytes <= maxBytes; bytes *= 4) {
+            runBenchmark(bytes / sizeof(int), lookups);
+        }
+        return 0;
+    }
+
+    // Same data as BinarySearchUsingRecursion.py
+    int arr[] = {1, 2, 3, 4, 5, 6, 7};
+    size_t n = sizeof(arr) / sizeof(arr[0]);
+    struct EytzingerIndex index;
+    eytzinger_build(&index, arr, n);
+
+    printf("Eytzinger order:");
+    for (size_t k = 1; k <= n; k++) printf(" %d", index.keys[k]);
+    printf("\n");
+
+    printf("Element found at index %ld\n", eytzinger_search(&index, 5));  // 4
+    printf("Searching for 8: %ld\n", eytzinger_search(&index, 8));        // -1
+    printf("lower_bound(0) = %zu, upper_bound(4) = %zu, lower_bound(9) = %zu\n",
+           eytzinger_lower_bound(&index, 0), eytzinger_upper_bound(&index, 4),
+           eytzinger_lower_bound(&index, 9));
+
+    int xs[] = {7, 1, 10, 3};
+    long found[4];
+    search_many(&index, xs, 4, found);
+    for (int i = 0; i < 4; i++) {
+        printf("search_many: %d -> %ld\n", xs[i], found[i]);
+    }
+
+    eytzinger_destroy(&index);
+    return 0;
+}
@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// N-Queens with bitboards, mirror symmetry and a work-stealing thread pool.
+//
+// NQueensProblem.py and NQueens.java check every placement by scanning a 2D
+// board. Here the attacked squares of the next row are three bitmasks: the
+// occupied columns and the two diagonal directions, which shift one column
+// per row. The free squares are all & ~(cols | left | right), and each free
+// square is peeled off with bit & -bit. The search keeps its own stack in
+// arrays instead of recursing.
+//
+// Every solution has a mirror image, so the first queen only tries the left
+// half of the first row and each solution found counts twice. With n odd, a
+// queen in the middle column is its own mirror; then the second queen is
+// restricted to the left half instead.
+//
+// The first rows are expanded into independent tasks, which are dealt out to
+// per-thread queues. A thread takes tasks from the front of its own queue and,
+// when that runs dry, steals from the back of another thread's queue.
+
+#define MAX_QUEENS 31
+#define SPLIT_ROWS 3      // Rows placed while generating tasks
+#define MAX_THREADS 64
+
+// Receives each solution: queens[r] is the column of the queen in row r.
+// Called from worker threads, possibly at the same time.
+typedef void (*SolutionFn)(const int* queens, int n, void* context);
+
+struct QueensTask {
+    uint32_t cols, left, right;  // Squares attacked in the next row
+    int row;                     // Rows already placed
+    int weight;                  // 2 when the mirror image is counted too
+    int halfOnly;                // The next queen must go in the left half
+    int queens[SPLIT_ROWS];
+};
+
+static int lowestColumn(uint32_t bit) {
+    return __builtin_ctz(bit);
+}
+
+// Count (and optionally emit) the solutions below one task. Tasks never
+// cover the last row, so there is always at least one row left to search.
+static uint64_t searchTask(int n, const struct QueensTask* task, SolutionFn emit, void* context) {
+    uint32_t all = (1u << n) - 1;
+    uint32_t cols[MAX_QUEENS], left[MAX_QUEENS], right[MAX_QUEENS], open[MAX_QUEENS];
+    int queens[MAX_QUEENS], mirror[MAX_QUEENS];
+    int base = task->row;
+    int row = base;
+    uint64_t count = 0;
+
+    memcpy(queens, task->queens, base * sizeof(int));
+    cols[row] = task->cols;
+    left[row] = task->left;
+    right[row] = task->right;
+    open[row] = all & ~(cols[row] | left[row] | right[row]);
+    while (row >= base) {
+        uint32_t available = open[row];
+        if (available == 0) {
+            row--;  // Backtrack
+            continue;
+        }
+        uint32_t bit = available & -available;
+        open[row] = available ^ bit;
+        if (emit != NULL) queens[row] = lowestColumn(bit);
+        if (row == n - 1) {
+            count++;
+            if (emit != NULL) {
+                emit(queens, n, context);
+                if (task->weight == 2) {
+                    for (int r = 0; r < n; r++) mirror[r] = n - 1 - queens[r];
+                    emit(mirror, n, context);
+                }
+            }
+            continue;
+        }
+        uint32_t nextCols = cols[row] | bit;
+        uint32_t nextLeft = (left[row] | bit) << 1;
+        uint32_t nextRight = (right[row] | bit) >> 1;
+        uint32_t nextOpen = all & ~(nextCols | nextLeft | nextRight);
+        if (emit == NULL && row == n - 2) {
+            // Counting only: every open square in the last row is a solution
+            count += __builtin_popcount(nextOpen);
+            continue;
+        }
+        row++;
+        cols[row] = nextCols;
+        left[row] = nextLeft;
+        right[row] = nextRight;
+        open[row] = nextOpen;
+    }
+    return count * task->weight;
+}
+
+// Place the first rows and return the resulting tasks (the caller frees them)
+static struct QueensTask* makeTasks(int n, int splitRows, int* taskCount) {
+    uint32_t all = (1u << n) - 1;
+    int capacity = 1;
+    for (int r = 0; r < splitRows; r++) capacity *= n;
+    struct QueensTask* current = (struct QueensTask*)malloc(capacity * sizeof(struct QueensTask));
+    struct QueensTask* next = (struct QueensTask*)malloc(capacity * sizeof(struct QueensTask));
+    if (current == NULL || next == NULL) {
+        free(current);
+        free(next);
+        return NULL;
+    }
+    memset(&current[0], 0, sizeof(struct QueensTask));
+    current[0].weight = 1;
+    int count = 1;
+
+    for (int row = 0; row < splitRows; row++) {
+        int produced = 0;
+        for (int t = 0; t < count; t++) {
+            struct QueensTask* task = &current[t];
+            uint32_t available = all & ~(task->cols | task->left | task->right);
+            if (row == 0 || task->halfOnly) {
+                available &= (1u << (n / 2)) - 1;  // Left half only; the mirror covers the rest
+                if (row == 0 && (n & 1)) available |= 1u << (n / 2);
+            }
+            while (available != 0) {
+                uint32_t bit = available & -available;
+                available ^= bit;
+                struct QueensTask* child = &next[produced++];
+                *child = *task;
+                child->queens[row] = lowestColumn(bit);
+                child->row = row + 1;
+                child->cols = task->cols | bit;
+                child->left = (task->left | bit) << 1;
+                child->right = (task->right | bit) >> 1;
+                child->halfOnly = row == 0 && child->queens[0] == n / 2 && (n & 1);
+                if (row == 0) child->weight = 2;
+            }
+        }
+        struct QueensTask* swap = current;
+        current = next;
+        next = swap;
+        count = produced;
+    }
+    free(next);
+    *taskCount = count;
+    return current;
+}
+
+// ---------------------------------------------------------------------------
+// Work-stealing pool
+// ---------------------------------------------------------------------------
+
+// One thread's share of the tasks: the owner takes from head, thieves from tail
+struct TaskQueue {
+    pthread_mutex_t lock;
+    int head, tail;
+    uint64_t count;      // Solutions found by the owning thread
+    char padding[64];    // Keep neighbouring queues off each other's cache lines
+};
+
+struct QueensPool {
+    int n;
+    const struct QueensTask* tasks;
+    struct TaskQueue* queues;
+    int threads;
+    SolutionFn emit;
+    void* context;
+};
+
+struct WorkerArg {
+    struct QueensPool* pool;
+    int id;
+};
+
+// Take a task from the front of queue q, or steal one from its back
+static int takeTask(struct TaskQueue* q, int steal) {
+    int index = -1;
+    pthread_mutex_lock(&q->lock);
+    if (q->head < q->tail) {
+        index = steal ? --q->tail : q->head++;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return index;
+}
+
+static void* worker(void* arg) {
+    struct WorkerArg* self = (struct WorkerArg*)arg;
+    struct QueensPool* pool = self->pool;
+    struct TaskQueue* own = &pool->queues[self->id];
+    uint64_t count = 0;
+    for (;;) {
+        int index = takeTask(own, 0);
+        // Own queue empty: no task is ever added, so steal until every queue is empty
+        for (int k = 1; index < 0 && k < pool->threads; k++) {
+            index = takeTask(&pool->queues[(self->id + k) % pool->threads], 1);
+        }
+        if (index < 0) break;
+        count += searchTask(pool->n, &pool->tasks[index], pool->emit, pool->context);
+    }
+    own->count = count;
+    return NULL;
+}
+
+// Number of solutions for an n x n board (1 <= n <= MAX_QUEENS), searched by
+// `threads` threads. If emit is not NULL every solution is passed to it as well.
+// Returns 0 for an invalid n or when out of memory.
+uint64_t solve_n_queens(int n, int threads, SolutionFn emit, void* context) {
+    if (n < 1 || n > MAX_QUEENS) return 0;
+    if (n == 1) {
+        // The only case where the first queen's mirror is the same solution
+        int queen = 0;
+        if (emit != NULL) emit(&queen, 1, context);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    int taskCount = 0;
+    int splitRows = n - 1 < SPLIT_ROWS ? n - 1 : SPLIT_ROWS;
+    struct QueensTask* tasks = makeTasks(n, splitRows, &taskCount);
+    if (tasks == NULL) return 0;
+
+    uint64_t total = 0;
+    if (threads == 1) {
+        for (int t = 0; t < taskCount; t++) total += searchTask(n, &tasks[t], emit, context);
+        free(tasks);
+        return total;
+    }
+
+    // Deal the tasks out in contiguous blocks
+    struct TaskQueue queues[MAX_THREADS];
+    struct WorkerArg args[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    struct QueensPool pool = {n, tasks, queues, threads, emit, context};
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_init(&queues[i].lock, NULL);
+        queues[i].head = (int)((long long)taskCount * i / threads);
+        queues[i].tail = (int)((long long)taskCount * (i + 1) / threads);
+        queues[i].count = 0;
+        args[i].pool = &pool;
+        args[i].id = i;
+    }
+    for (int i = 0; i < threads; i++) pthread_create(&ids[i], NULL, worker, &args[i]);
+    for (int i = 0; i < threads; i++) pthread_join(ids[i], NULL);
+    // Only now: a thread still running may steal from any queue
+    for (int i = 0; i < threads; i++) {
+        total += queues[i].count;
+        pthread_mutex_destroy(&queues[i].lock);
+    }
+    free(tasks);
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: the 2D-board version against the bitboards
+// ---------------------------------------------------------------------------
+
+// The approach of NQueensProblem.py / NQueens.java, counting instead of printing
+static int isSafe(char board[][MAX_QUEENS], int row, int col, int n) {
+    for (int i = 0; i < col; i++)
+        if (board[row][i])
+            return 0;
+    for (int i = row, j = col; i >= 0 && j >= 0; i--, j--)
+        if (board[i][j])
+            return 0;
+    for (int i = row, j = col; i < n && j >= 0; i++, j--)
+        if (board[i][j])
+            return 0;
+    return 1;
+}
+
+static uint64_t solveNaive(char board[][MAX_QUEENS], int col, int n) {
+    if (col >= n) return 1;
+    uint64_t count = 0;
+    for (int i = 0; i < n; i++) {
+        if (isSafe(board, i, col, n)) {
+            board[i][col] = 1;
+            count += solveNaive(board, col + 1, n);
+            board[i][col] = 0;  // Backtrack
+        }
+    }
+    return count;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define NAIVE_MAX_N 12  // The 2D board takes minutes beyond this
+
+static void runBenchmark(int maxN, int threads) {
+    static const uint64_t known[] = {0, 1, 0, 0, 2, 10, 4, 40, 92, 352, 724, 2680, 14200, 73712,
+                                     365596, 2279184, 14772512, 95815104, 666090624,
+                                     4968057848ULL, 39029188884ULL};
+    char parallelLabel[32];
+    snprintf(parallelLabel, sizeof(parallelLabel), "bitboard %dT/s", threads);
+    printf("%3s %14s %16s %16s %16s\n", "n", "solutions", "2D board/s", "bitboard 1T/s", parallelLabel);
+    for (int n = 8; n <= maxN; n++) {
+        char naiveText[32] = "skipped";
+        if (n <= NAIVE_MAX_N) {
+            static char board[MAX_QUEENS][MAX_QUEENS];
+            memset(board, 0, sizeof(board));
+            double t0 = nowSeconds();
+            uint64_t naive = solveNaive(board, 0, n);
+            snprintf(naiveText, sizeof(naiveText), "%.0f", naive / (nowSeconds() - t0));
+        }
+        double t0 = nowSeconds();
+        uint64_t single = solve_n_queens(n, 1, NULL, NULL);
+        double singleTime = nowSeconds() - t0;
+        t0 = nowSeconds();
+        uint64_t parallel = solve_n_queens(n, threads, NULL, NULL);
+        double parallelTime = nowSeconds() - t0;
+
+        int wrong = single != parallel ||
+                    (n < (int)(sizeof(known) / sizeof(known[0])) && single != known[n]);
+        printf("%3d %14llu %16s %16.0f %16.0f%s\n", n, (unsigned long long)single, naiveText,
+               single / singleTime, parallel / parallelTime, wrong ? "  (wrong count)" : "");
+    }
+}
+
+// Streaming example: print each board as it is found
+static void printBoard(const int* queens, int n, void* context) {
+    pthread_mutex_t* lock = (pthread_mutex_t*)context;
+    pthread_mutex_lock(lock);
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            printf(queens[r] == c ? "Q " : ". ");
+        }
+        printf("\n");
+    }
+    printf("\n");
+    pthread_mutex_unlock(lock);
+}
+
+int main(int argc, char *argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 1 ? (int)cpus : 2;
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [maxN] [threads]
+        int maxN = argc > 2 ? atoi(argv[2]) : 16;
+        if (argc > 3) threads = atoi(argv[3]);
+        runBenchmark(maxN, threads);
+        return 0;
+    }
+
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    int n = 4;
+    uint64_t count = solve_n_queens(n, 1, printBoard, &lock);
+    printf("%d-queens: %llu solutions\n", n, (unsigned long long)count);
+
+    for (n = 8; n <= 12; n++) {
+        printf("%d-queens: %llu solutions\n", n, (unsigned long long)solve_n_queens(n, threads, NULL, NULL));
+    }
+    return 0;
+}
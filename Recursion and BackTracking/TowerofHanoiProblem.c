@@ -0,0 +1,326 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Tower of Hanoi without recursion or replay.
+//
+// Solving n disks takes 2^n - 1 moves. Numbering them k = 1, 2, ..., move k
+// is fixed by k alone:
+//   disk = ctz(k) + 1
+//   from = (k & (k - 1)) % 3
+//   to   = ((k | (k - 1)) + 1) % 3
+// on pegs 0, 1, 2 where the tower ends on peg 2 for odd n and on peg 1 for
+// even n; swapping the two for even n gives source -> target for every n.
+// So any move can be computed directly, moves can be written straight into
+// a buffer, and ranges of moves can be generated on separate threads.
+//
+// The position after k moves also needs no replay: disk n has moved iff
+// k >= 2^(n-1), and the question repeats for the smaller tower, n steps in all.
+
+#define HANOI_MAX_DISKS 63   // 2^63 - 1 moves still fit in uint64_t
+#define MAX_THREADS 64
+
+// Peg numbers, in the order the demo labels them A, B, C
+#define HANOI_SOURCE 0
+#define HANOI_AUXILIARY 1
+#define HANOI_TARGET 2
+
+struct HanoiMove {
+    int disk;   // 1 is the smallest
+    int from;
+    int to;
+};
+
+// Which disks sit on each peg: bit d - 1 is set when disk d is there
+struct HanoiState {
+    uint64_t pegs[3];
+};
+
+// Packed move: disk in the low byte, then 2 bits each for from and to
+typedef uint16_t PackedMove;
+
+static inline PackedMove packMove(int disk, int from, int to) {
+    return (PackedMove)(disk | from << 8 | to << 10);
+}
+
+static inline struct HanoiMove unpackMove(PackedMove packed) {
+    struct HanoiMove move = {packed & 0xff, (packed >> 8) & 3, (packed >> 10) & 3};
+    return move;
+}
+
+static inline uint64_t hanoiMoveCount(int n) {
+    return ((uint64_t)1 << n) - 1;
+}
+
+// The formula's peg 1 is the target for even n; map it back to our numbering
+static inline int pegMapping(int n, int peg) {
+    return (n & 1) || peg == 0 ? peg : 3 - peg;
+}
+
+// Move number k (1-based) of the n-disk solution. Returns 0, or -1 if k is
+// out of range.
+int hanoiMoveAt(int n, uint64_t k, struct HanoiMove* move) {
+    if (n < 1 || n > HANOI_MAX_DISKS || k < 1 || k > hanoiMoveCount(n)) return -1;
+    move->disk = __builtin_ctzll(k) + 1;
+    move->from = pegMapping(n, (int)((k & (k - 1)) % 3));
+    move->to = pegMapping(n, (int)(((k | (k - 1)) + 1) % 3));
+    return 0;
+}
+
+// Where every disk is after the first k moves, in O(n). Returns 0, or -1 if
+// k is out of range.
+int hanoiStateAfter(int n, uint64_t k, struct HanoiState* state) {
+    if (n < 1 || n > HANOI_MAX_DISKS || k > hanoiMoveCount(n)) return -1;
+    int source = HANOI_SOURCE, target = HANOI_TARGET, spare = HANOI_AUXILIARY;
+    state->pegs[0] = state->pegs[1] = state->pegs[2] = 0;
+    for (int disk = n; disk >= 1; disk--) {
+        uint64_t half = (uint64_t)1 << (disk - 1);  // Moves before this disk moves
+        int t;
+        if (k < half) {
+            // Smaller tower still heading for the spare peg
+            state->pegs[source] |= half;
+            t = target; target = spare; spare = t;
+        } else {
+            // This disk is done; the smaller tower moves from spare to target
+            state->pegs[target] |= half;
+            k -= half;
+            t = source; source = spare; spare = t;
+        }
+    }
+    return 0;
+}
+
+// Write moves first .. first + count - 1 into out. Returns 0, or -1 if the
+// range is out of bounds.
+int hanoiMoves(int n, uint64_t first, uint64_t count, PackedMove* out) {
+    if (n < 1 || n > HANOI_MAX_DISKS || first < 1 || first > hanoiMoveCount(n) ||
+        count > hanoiMoveCount(n) - first + 1) return -1;
+    uint8_t map[3];
+    for (int p = 0; p < 3; p++) map[p] = (uint8_t)pegMapping(n, p);
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t k = first + i;
+        int disk = __builtin_ctzll(k) + 1;
+        int from = map[(k & (k - 1)) % 3];
+        int to = map[((k | (k - 1)) + 1) % 3];
+        out[i] = packMove(disk, from, to);
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Parallel ranges
+// ---------------------------------------------------------------------------
+
+struct MoveJob {
+    int n;
+    uint64_t first, count;
+    PackedMove* out;
+};
+
+static void* runMoveJob(void* arg) {
+    struct MoveJob* job = (struct MoveJob*)arg;
+    hanoiMoves(job->n, job->first, job->count, job->out);
+    return NULL;
+}
+
+// Write all 2^n - 1 moves into out (which must hold that many), splitting the
+// range across `threads` threads. Returns 0, or -1 if n is out of range.
+// A thread that cannot be started has its range generated on the caller.
+int hanoiMovesParallel(int n, int threads, PackedMove* out) {
+    if (n < 1 || n > HANOI_MAX_DISKS) return -1;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    uint64_t total = hanoiMoveCount(n);
+    if ((uint64_t)threads > total) threads = (int)total;
+
+    struct MoveJob jobs[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    int started[MAX_THREADS];
+    uint64_t first = 1;
+    for (int t = 0; t < threads; t++) {
+        jobs[t].n = n;
+        jobs[t].first = first;
+        jobs[t].count = total / threads + ((uint64_t)t < total % threads);
+        jobs[t].out = out + (first - 1);
+        first += jobs[t].count;
+        started[t] = t > 0 && pthread_create(&ids[t], NULL, runMoveJob, &jobs[t]) == 0;
+    }
+    runMoveJob(&jobs[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(ids[t], NULL);
+        } else {
+            runMoveJob(&jobs[t]);
+        }
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+// The recursion from TowerofHanoiProblem.py, printing through stdio
+static void towerOfHanoi(FILE* out, int n, char source, char target, char auxiliary) {
+    if (n == 1) {
+        fprintf(out, "Move disk 1 from %c to %c\n", source, target);
+        return;
+    }
+    towerOfHanoi(out, n - 1, source, auxiliary, target);
+    fprintf(out, "Move disk %d from %c to %c\n", n, source, target);
+    towerOfHanoi(out, n - 1, auxiliary, target, source);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define CHUNK_MOVES 65536  // Moves per buffer fill in the streaming runs
+
+// Generate a range of moves a chunk at a time, the way a consumer writing
+// them to a file or socket would, and fold them into a checksum
+struct ChunkJob {
+    int n;
+    uint64_t first, count;
+    uint64_t checksum;
+};
+
+static void* runChunkJob(void* arg) {
+    struct ChunkJob* job = (struct ChunkJob*)arg;
+    PackedMove* buffer = (PackedMove*)malloc(CHUNK_MOVES * sizeof(PackedMove));
+    uint64_t sum = 0;
+    if (buffer == NULL) return NULL;
+    for (uint64_t done = 0; done < job->count; done += CHUNK_MOVES) {
+        uint64_t count = job->count - done < CHUNK_MOVES ? job->count - done : CHUNK_MOVES;
+        hanoiMoves(job->n, job->first + done, count, buffer);
+        for (uint64_t i = 0; i < count; i++) sum += buffer[i];
+    }
+    job->checksum = sum;
+    free(buffer);
+    return NULL;
+}
+
+static double streamMoves(int n, int threads, uint64_t* checksum) {
+    struct ChunkJob jobs[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    int started[MAX_THREADS];
+    uint64_t total = hanoiMoveCount(n), first = 1;
+    double t0 = nowSeconds();
+    for (int t = 0; t < threads; t++) {
+        jobs[t].n = n;
+        jobs[t].first = first;
+        jobs[t].count = total / threads + ((uint64_t)t < total % threads);
+        jobs[t].checksum = 0;
+        first += jobs[t].count;
+        started[t] = t > 0 && pthread_create(&ids[t], NULL, runChunkJob, &jobs[t]) == 0;
+    }
+    runChunkJob(&jobs[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(ids[t], NULL);
+        } else {
+            runChunkJob(&jobs[t]);
+        }
+    }
+    double elapsed = nowSeconds() - t0;
+    *checksum = 0;
+    for (int t = 0; t < threads; t++) *checksum += jobs[t].checksum;
+    return elapsed;
+}
+
+static void runBenchmark(int n, int stdioN, int threads) {
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    FILE* sink = fopen("/dev/null", "w");
+    double t0 = nowSeconds();
+    if (sink != NULL) {
+        towerOfHanoi(sink, stdioN, 'A', 'C', 'B');
+        fclose(sink);
+    }
+    double stdioTime = nowSeconds() - t0;
+
+    // Whole solution in one buffer, for a size that fits comfortably
+    int bufferN = stdioN;
+    PackedMove* all = (PackedMove*)malloc(hanoiMoveCount(bufferN) * sizeof(PackedMove));
+    t0 = nowSeconds();
+    hanoiMovesParallel(bufferN, 1, all);
+    double bufferTime = nowSeconds() - t0;
+
+    // Spot check random access against the buffer
+    int mismatches = 0;
+    for (uint64_t k = 1; k <= hanoiMoveCount(bufferN); k += 9973) {
+        struct HanoiMove move, stored = unpackMove(all[k - 1]);
+        hanoiMoveAt(bufferN, k, &move);
+        mismatches += move.disk != stored.disk || move.from != stored.from || move.to != stored.to;
+    }
+    free(all);
+
+    uint64_t single, parallel;
+    double singleTime = streamMoves(n, 1, &single);
+    double parallelTime = streamMoves(n, threads, &parallel);
+
+    struct HanoiState state;
+    uint64_t k = hanoiMoveCount(n) / 3;
+    t0 = nowSeconds();
+    for (int r = 0; r < 1000000; r++) hanoiStateAfter(n, k + r, &state);
+    double stateTime = (nowSeconds() - t0) / 1000000;
+
+    printf("%-34s %4s %16s\n", "generator", "n", "moves/sec");
+    printf("%-34s %4d %16.0f\n", "recursion + fprintf (.py style)", stdioN, hanoiMoveCount(stdioN) / stdioTime);
+    printf("%-34s %4d %16.0f\n", "formula, whole buffer", bufferN, hanoiMoveCount(bufferN) / bufferTime);
+    printf("%-34s %4d %16.0f\n", "formula, 64K-move chunks", n, hanoiMoveCount(n) / singleTime);
+    char label[48];
+    snprintf(label, sizeof(label), "formula, 64K-move chunks, %d thr", threads);
+    printf("%-34s %4d %16.0f\n", label, n, hanoiMoveCount(n) / parallelTime);
+    printf("\nState after k moves: %.1f ns\n", stateTime * 1e9);
+    if (single != parallel || mismatches != 0) printf("move streams disagree\n");
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [n] [stdioN] [threads]
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        int n = argc > 2 ? atoi(argv[2]) : 30;
+        int stdioN = argc > 3 ? atoi(argv[3]) : 22;
+        int threads = argc > 4 ? atoi(argv[4]) : (cpus > 1 ? (int)cpus : 2);
+        if (n < 1 || n > HANOI_MAX_DISKS || stdioN < 1 || stdioN > 30) {
+            printf("n must be 1..%d and stdioN 1..30\n", HANOI_MAX_DISKS);
+            return 1;
+        }
+        runBenchmark(n, stdioN, threads);
+        return 0;
+    }
+
+    // Same output as tower_of_hanoi(3, 'A', 'C', 'B')
+    const char labels[] = "ABC";
+    PackedMove moves[7];
+    hanoiMoves(3, 1, 7, moves);
+    for (int i = 0; i < 7; i++) {
+        struct HanoiMove move = unpackMove(moves[i]);
+        printf("Move disk %d from %c to %c\n", move.disk, labels[move.from], labels[move.to]);
+    }
+
+    // Jump into the middle of a 40-disk solution
+    struct HanoiMove move;
+    uint64_t k = 500000000000ULL;
+    hanoiMoveAt(40, k, &move);
+    printf("Move %llu of 40 disks: disk %d from %c to %c\n", (unsigned long long)k,
+           move.disk, labels[move.from], labels[move.to]);
+
+    struct HanoiState state;
+    hanoiStateAfter(3, 4, &state);
+    for (int p = 0; p < 3; p++) {
+        printf("%c:", labels[p]);
+        for (int disk = 3; disk >= 1; disk--) {
+            if (state.pegs[p] >> (disk - 1) & 1) printf(" %d", disk);
+        }
+        printf("\n");
+    }
+    return 0;
+}
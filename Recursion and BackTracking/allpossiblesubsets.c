@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Subset enumeration without building a list of subsets.
+//
+// allpossiblesubsets.py appends a copy of every subset to one result list, so
+// memory grows as 2^n lists before the caller sees anything. Here a subset of
+// n <= 63 elements is a bitmask (bit i set when element i is in it) and the
+// subsets are handed to a callback, or read from an iterator, one at a time.
+// Nothing is allocated.
+//
+// The default order is the binary reflected Gray code: subset number i is
+// i ^ (i >> 1), and consecutive subsets differ in exactly one element (element
+// ctz(i) when going from i - 1 to i). A caller can keep running totals and
+// update them in O(1) per subset. Because subset i can be computed directly,
+// the 2^n subsets split into independent ranges for threads.
+//
+// Lexicographic order (the order allpossiblesubsets.py prints) is also
+// available, one thread only.
+
+#define MAX_ELEMENTS 63
+#define MAX_THREADS 64
+
+// Called once per subset. `changed` is the element added or removed since the
+// previous call, or -1 when the whole mask should be read afresh (the first
+// subset of a range, and every subset in lexicographic order). Return nonzero
+// to stop the enumeration.
+typedef int (*SubsetFn)(uint64_t mask, int changed, void* context);
+
+static inline uint64_t grayCode(uint64_t i) {
+    return i ^ (i >> 1);
+}
+
+// Subsets number begin..end-1 in Gray-code order. Returns 1 if fn stopped early.
+int forEachSubsetRange(uint64_t begin, uint64_t end, SubsetFn fn, void* context) {
+    if (begin >= end) return 0;
+    uint64_t mask = grayCode(begin);
+    if (fn(mask, -1, context)) return 1;
+    for (uint64_t i = begin + 1; i < end; i++) {
+        int changed = __builtin_ctzll(i);
+        mask ^= (uint64_t)1 << changed;
+        if (fn(mask, changed, context)) return 1;
+    }
+    return 0;
+}
+
+// All 2^n subsets in Gray-code order, starting with the empty set
+int forEachSubset(int n, SubsetFn fn, void* context) {
+    if (n < 0 || n > MAX_ELEMENTS) return 0;
+    return forEachSubsetRange(0, (uint64_t)1 << n, fn, context);
+}
+
+// Iterator over a range of Gray-code subsets, for callers that want a loop
+struct SubsetIterator {
+    uint64_t next;   // Number of the next subset
+    uint64_t end;
+    uint64_t mask;   // The subset last returned
+    int started;
+};
+
+void subsetIteratorInit(struct SubsetIterator* it, uint64_t begin, uint64_t end) {
+    it->next = begin;
+    it->end = end;
+    it->mask = grayCode(begin);
+    it->started = 0;
+}
+
+// Store the next subset and the element that changed (-1 for the first);
+// returns 0 when the range is exhausted
+int subsetIteratorNext(struct SubsetIterator* it, uint64_t* mask, int* changed) {
+    if (it->next >= it->end) return 0;
+    if (!it->started) {
+        it->started = 1;
+        *changed = -1;
+    } else {
+        *changed = __builtin_ctzll(it->next);
+        it->mask ^= (uint64_t)1 << *changed;
+    }
+    it->next++;
+    *mask = it->mask;
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Parallel ranges
+// ---------------------------------------------------------------------------
+
+struct RangeJob {
+    uint64_t begin, end;
+    SubsetFn fn;
+    void* context;
+};
+
+static void* runRange(void* arg) {
+    struct RangeJob* job = (struct RangeJob*)arg;
+    forEachSubsetRange(job->begin, job->end, job->fn, job->context);
+    return NULL;
+}
+
+// All 2^n subsets, split into `threads` equal ranges run at the same time.
+// Thread t passes contexts[t] to fn, so each thread can keep its own totals;
+// fn stopping early ends only its own range. Returns 0, or -1 if a thread
+// could not be started (its range is then run on the calling thread).
+int forEachSubsetParallel(int n, int threads, SubsetFn fn, void** contexts) {
+    if (n < 0 || n > MAX_ELEMENTS) return 0;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    uint64_t total = (uint64_t)1 << n;
+    if ((uint64_t)threads > total) threads = (int)total;
+
+    struct RangeJob jobs[MAX_THREADS];
+    pthread_t ids[MAX_THREADS];
+    int started[MAX_THREADS];
+    int status = 0;
+    for (int t = 0; t < threads; t++) {
+        jobs[t].begin = total / threads * t + (total % threads < (uint64_t)t ? total % threads : (uint64_t)t);
+        jobs[t].end = jobs[t].begin + total / threads + ((uint64_t)t < total % threads);
+        jobs[t].fn = fn;
+        jobs[t].context = contexts[t];
+        started[t] = t > 0 && pthread_create(&ids[t], NULL, runRange, &jobs[t]) == 0;
+        if (t > 0 && !started[t]) status = -1;
+    }
+    runRange(&jobs[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(ids[t], NULL);
+        } else {
+            runRange(&jobs[t]);
+        }
+    }
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Lexicographic order
+// ---------------------------------------------------------------------------
+
+// The subset after `mask` when subsets are compared as sorted lists of
+// elements: {}, {0}, {0,1}, {0,1,2}, {0,2}, {1}, ... Returns 0 after the last one.
+static inline int nextLexicographic(uint64_t* mask, int n) {
+    uint64_t m = *mask;
+    if (m == 0) {
+        if (n == 0) return 0;
+        *mask = 1;
+        return 1;
+    }
+    int high = 63 - __builtin_clzll(m);
+    if (high < n - 1) {
+        *mask = m | ((uint64_t)1 << (high + 1));  // Extend with the next element
+        return 1;
+    }
+    // The last element is n - 1: drop it and advance the one before it
+    m &= ~((uint64_t)1 << high);
+    if (m == 0) return 0;
+    high = 63 - __builtin_clzll(m);
+    *mask = (m & ~((uint64_t)1 << high)) | ((uint64_t)1 << (high + 1));
+    return 1;
+}
+
+// All 2^n subsets in lexicographic order, starting with the empty set
+int forEachSubsetLexicographic(int n, SubsetFn fn, void* context) {
+    if (n < 0 || n > MAX_ELEMENTS) return 0;
+    uint64_t mask = 0;
+    do {
+        if (fn(mask, -1, context)) return 1;
+    } while (nextLexicographic(&mask, n));
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+// The approach of allpossiblesubsets.py: a copy of every subset in one big list
+struct SubsetList {
+    int** subsets;
+    int* sizes;
+    size_t count;
+    size_t bytes;    // Heap bytes held by the list
+};
+
+static void findSubsets(const int* nums, int n, int index, int* path, int depth, struct SubsetList* result) {
+    int* copy = (int*)malloc((depth > 0 ? depth : 1) * sizeof(int));
+    memcpy(copy, path, depth * sizeof(int));
+    result->subsets[result->count] = copy;
+    result->sizes[result->count++] = depth;
+    result->bytes += (depth > 0 ? depth : 1) * sizeof(int) + sizeof(int*) + sizeof(int);
+    for (int i = index; i < n; i++) {
+        path[depth] = nums[i];
+        findSubsets(nums, n, i + 1, path, depth + 1, result);
+    }
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Benchmark callback: count the subsets whose elements sum to a target,
+// keeping the sum up to date from the one element that changed
+struct SubsetSum {
+    const int* values;
+    long long sum;
+    long long target;
+    uint64_t matches;
+    uint64_t visited;
+};
+
+static int countTargetSums(uint64_t mask, int changed, void* context) {
+    struct SubsetSum* s = (struct SubsetSum*)context;
+    if (changed < 0) {
+        s->sum = 0;
+        for (uint64_t m = mask; m != 0; m &= m - 1) s->sum += s->values[__builtin_ctzll(m)];
+    } else if (mask >> changed & 1) {
+        s->sum += s->values[changed];
+    } else {
+        s->sum -= s->values[changed];
+    }
+    s->matches += s->sum == s->target;
+    s->visited++;
+    return 0;
+}
+
+static void runBenchmark(int n, int listN, int threads) {
+    int values[MAX_ELEMENTS];
+    for (int i = 0; i < n; i++) values[i] = i + 1;
+    long long target = (long long)n * (n + 1) / 4;
+
+    // Materializing baseline (smaller n: it needs the whole list in memory)
+    struct SubsetList list;
+    int path[MAX_ELEMENTS];
+    list.count = 0;
+    list.bytes = 0;
+    list.subsets = (int**)malloc(((size_t)1 << listN) * sizeof(int*));
+    list.sizes = (int*)malloc(((size_t)1 << listN) * sizeof(int));
+    double t0 = nowSeconds();
+    findSubsets(values, listN, 0, path, 0, &list);
+    double listTime = nowSeconds() - t0;
+    for (size_t i = 0; i < list.count; i++) free(list.subsets[i]);
+    free(list.subsets);
+    free(list.sizes);
+
+    struct SubsetSum single = {values, 0, target, 0, 0};
+    t0 = nowSeconds();
+    forEachSubset(n, countTargetSums, &single);
+    double grayTime = nowSeconds() - t0;
+
+    struct SubsetSum lex = {values, 0, target, 0, 0};
+    t0 = nowSeconds();
+    forEachSubsetLexicographic(n, countTargetSums, &lex);
+    double lexTime = nowSeconds() - t0;
+
+    struct SubsetSum parts[MAX_THREADS];
+    void* contexts[MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        struct SubsetSum blank = {values, 0, target, 0, 0};
+        parts[t] = blank;
+        contexts[t] = &parts[t];
+    }
+    t0 = nowSeconds();
+    forEachSubsetParallel(n, threads, countTargetSums, contexts);
+    double parallelTime = nowSeconds() - t0;
+    uint64_t parallelMatches = 0, parallelVisited = 0;
+    for (int t = 0; t < threads; t++) {
+        parallelMatches += parts[t].matches;
+        parallelVisited += parts[t].visited;
+    }
+
+    if (single.matches != lex.matches || single.matches != parallelMatches ||
+        parallelVisited != (uint64_t)1 << n) {
+        printf("enumerations disagree\n");
+    }
+    printf("Subsets of {1..%d} summing to %lld: %llu\n\n", n, target, (unsigned long long)single.matches);
+    printf("%-30s %4s %14s %16s\n", "enumerator", "n", "heap bytes", "subsets/sec");
+    printf("%-30s %4d %14zu %16.0f\n", "materialized list (.py style)", listN, list.bytes, list.count / listTime);
+    printf("%-30s %4d %14d %16.0f\n", "Gray code", n, 0, ((uint64_t)1 << n) / grayTime);
+    printf("%-30s %4d %14d %16.0f\n", "lexicographic", n, 0, ((uint64_t)1 << n) / lexTime);
+    char label[32];
+    snprintf(label, sizeof(label), "Gray code, %d threads", threads);
+    printf("%-30s %4d %14d %16.0f\n", label, n, 0, ((uint64_t)1 << n) / parallelTime);
+}
+
+static int printSubset(uint64_t mask, int changed, void* context) {
+    const int* nums = (const int*)context;
+    (void)changed;
+    printf("[");
+    for (uint64_t m = mask, first = 1; m != 0; m &= m - 1, first = 0) {
+        printf(first ? "%d" : ", %d", nums[__builtin_ctzll(m)]);
+    }
+    printf("] ");
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [n] [listN] [threads]
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        int n = argc > 2 ? atoi(argv[2]) : 28;
+        int listN = argc > 3 ? atoi(argv[3]) : 20;
+        int threads = argc > 4 ? atoi(argv[4]) : (cpus > 1 ? (int)cpus : 2);
+        runBenchmark(n, listN, threads);
+        return 0;
+    }
+
+    int nums[] = {1, 2, 3};
+    printf("Lexicographic: ");
+    forEachSubsetLexicographic(3, printSubset, nums);  // [] [1] [1, 2] [1, 2, 3] [1, 3] [2] [2, 3] [3]
+    printf("\nGray code:     ");
+    forEachSubset(3, printSubset, nums);               // [] [1] [1, 2] [2] [2, 3] [1, 2, 3] [1, 3] [3]
+    printf("\n");
+
+    // The same walk as a loop
+    struct SubsetIterator it;
+    uint64_t mask;
+    int changed;
+    subsetIteratorInit(&it, 0, 8);
+    printf("Changed elements:");
+    while (subsetIteratorNext(&it, &mask, &changed)) {
+        printf(" %d", changed);
+    }
+    printf("\n");
+    return 0;
+}
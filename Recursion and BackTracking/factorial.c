@@ -1,13 +1,154 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "BigNum.h"
 
-int factorial(int n) {
-    if (n == 0 || n == 1)  // Base case
-        return 1;
-    else
-        return n * factorial(n - 1);  // Recursive call
+#define FACTORIAL_U64_MAX_N 20  // 20! is the largest factorial that fits in uint64_t
+
+// n! in a uint64_t. Returns 0, or -1 if n! does not fit.
+int factorial_u64(unsigned n, uint64_t* result) {
+    uint64_t product = 1;
+    for (unsigned i = 2; i <= n; i++) {
+        if (__builtin_mul_overflow(product, (uint64_t)i, &product)) return -1;
+    }
+    *result = product;
+    return 0;
+}
+
+// n! exactly, with a balanced product tree (binary splitting).
+//
+// Multiplying 1 * 2 * ... * n one factor at a time makes every step a long
+// number times a short one, O(n^2) in total. Here the factors are first packed
+// into 64-bit leaves, then neighbours are multiplied pairwise, level by level,
+// so every big multiplication has operands of similar size and Karatsuba pays
+// off. The factors of two are taken out of every i and applied as one shift at
+// the end (n! has n - popcount(n) of them).
+// Returns 0, or -1 if out of memory.
+int factorial(unsigned n, struct BigNum* result) {
+    uint64_t small;
+    if (factorial_u64(n, &small) == 0) {
+        return bigSetU64(result, small);
+    }
+
+    // Leaves: products of odd parts that still fit in 64 bits
+    size_t count = 0;
+    struct BigNum* level = (struct BigNum*)malloc(((size_t)n / 2 + 1) * sizeof(struct BigNum));
+    if (level == NULL) return -1;
+    int status = 0;
+    uint64_t leaf = 1;
+    for (unsigned i = 3; i <= n; i++) {
+        uint64_t odd = i;
+        while ((odd & 1) == 0) odd >>= 1;
+        uint64_t next;
+        if (__builtin_mul_overflow(leaf, odd, &next)) {
+            bigInit(&level[count]);
+            status |= bigSetU64(&level[count++], leaf);
+            next = odd;
+        }
+        leaf = next;
+    }
+    bigInit(&level[count]);
+    status |= bigSetU64(&level[count++], leaf);
+
+    // Multiply neighbours until one number is left
+    while (count > 1 && status == 0) {
+        size_t half = 0;
+        for (size_t i = 0; i + 1 < count; i += 2) {
+            status |= bigMul(&level[i], &level[i], &level[i + 1]);
+            bigFree(&level[i + 1]);
+            bigSwap(&level[half++], &level[i]);
+        }
+        if (count & 1) bigSwap(&level[half++], &level[count - 1]);
+        count = half;
+    }
+
+    unsigned twos = n;
+    for (unsigned m = n; m != 0; m &= m - 1) twos--;  // n - popcount(n)
+    if (status == 0) status = bigShiftLeft(result, &level[0], twos);
+    for (size_t i = 0; i < count; i++) bigFree(&level[i]);
+    free(level);
+    return status == 0 ? 0 : -1;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+// One factor at a time: O(n^2) limb operations
+static int factorialSequential(unsigned n, struct BigNum* result) {
+    int status = bigSetU64(result, 1);
+    for (unsigned i = 2; i <= n && status == 0; i++) {
+        status = bigMulSmall(result, i);
+    }
+    return status;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define SEQUENTIAL_LIMIT 100000  // The O(n^2) baseline gets slow past this
+
+static void runBenchmark(void) {
+    unsigned sizes[] = {1000, 100000, 1000000};
+    printf("%10s %12s %16s %16s\n", "n", "bits", "product tree s", "sequential s");
+    for (int s = 0; s < 3; s++) {
+        unsigned n = sizes[s];
+        struct BigNum tree, sequential;
+        bigInit(&tree);
+        bigInit(&sequential);
+
+        int reps = n <= 1000 ? 1000 : 1;
+        double t0 = nowSeconds();
+        for (int r = 0; r < reps; r++) factorial(n, &tree);
+        double treeTime = (nowSeconds() - t0) / reps;
+
+        if (n <= SEQUENTIAL_LIMIT) {
+            t0 = nowSeconds();
+            factorialSequential(n, &sequential);
+            double sequentialTime = nowSeconds() - t0;
+            int same = tree.length == sequential.length &&
+                       memcmp(tree.limbs, sequential.limbs, tree.length * sizeof(uint32_t)) == 0;
+            printf("%10u %12zu %16.6f %16.6f%s\n", n, bigBitLength(&tree), treeTime, sequentialTime,
+                   same ? "" : "  (results differ)");
+        } else {
+            printf("%10u %12zu %16.6f %16s\n", n, bigBitLength(&tree), treeTime, "skipped");
+        }
+        bigFree(&tree);
+        bigFree(&sequential);
+    }
 }
 
-int main() {
-    printf("%d\n", factorial(5));  // Output: 120
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark();
+        return 0;
+    }
+
+    uint64_t small;
+    factorial_u64(5, &small);
+    printf("%llu\n", (unsigned long long)small);  // Output: 120
+
+    if (factorial_u64(21, &small) != 0) {
+        printf("21! does not fit in 64 bits\n");
+    }
+
+    struct BigNum f;
+    bigInit(&f);
+    factorial(30, &f);
+    char* text = bigToDecimal(&f);
+    printf("30! = %s\n", text);  // 265252859812191058636308480000000
+    free(text);
+
+    factorial(1000, &f);
+    text = bigToDecimal(&f);
+    printf("1000! has %zu digits: %.20s...\n", strlen(text), text);
+    free(text);
+
+    bigFree(&f);
     return 0;
 }
@@ -1,15 +1,175 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "BigNum.h"
 
-int fibonacci(int n) {
+#define FIB_U64_MAX_N 93  // F(93) is the largest Fibonacci number that fits in uint64_t
+
+// F(n) in a uint64_t. Returns 0, or -1 if F(n) does not fit.
+int fibonacci_u64(unsigned n, uint64_t* result) {
+    uint64_t a = 0, b = 1;  // F(i), F(i + 1)
+    if (n > FIB_U64_MAX_N) return -1;
+    for (unsigned i = 0; i < n; i++) {
+        uint64_t next;
+        // F(i + 2) may overflow on the last step even though F(n) fits
+        if (__builtin_add_overflow(a, b, &next)) next = 0;
+        a = b;
+        b = next;
+    }
+    *result = a;
+    return 0;
+}
+
+// F(n) exactly, by fast doubling: from (F(k), F(k + 1)),
+//   F(2k)     = F(k) * (2 F(k + 1) - F(k))
+//   F(2k + 1) = F(k)^2 + F(k + 1)^2
+// Walking the bits of n from the top, each step doubles k (and adds one for a
+// 1 bit), so only O(log n) big multiplications are needed.
+// Returns 0, or -1 if out of memory.
+int fibonacci(unsigned n, struct BigNum* result) {
+    uint64_t small;
+    if (fibonacci_u64(n, &small) == 0) {
+        return bigSetU64(result, small);
+    }
+
+    struct BigNum a, b, t, c, d;
+    bigInit(&a); bigInit(&b); bigInit(&t); bigInit(&c); bigInit(&d);
+    int status = bigSetU64(&a, 0) | bigSetU64(&b, 1);
+
+    int top = 31;
+    while (!((n >> top) & 1)) top--;
+    for (int bit = top; bit >= 0 && status == 0; bit--) {
+        int odd = (n >> bit) & 1;
+        int last = bit == 0;
+        // The last step needs only F(n), not F(n + 1)
+        if (!last || !odd) {
+            status |= bigShiftLeft(&t, &b, 1);
+            status |= bigSub(&t, &t, &a);
+            status |= bigMul(&c, &a, &t);       // F(2k)
+        }
+        if (!last || odd) {
+            status |= bigMul(&d, &a, &a);
+            status |= bigMul(&t, &b, &b);
+            status |= bigAdd(&d, &d, &t);       // F(2k + 1)
+        }
+        if (last) {
+            bigSwap(&a, odd ? &d : &c);
+        } else if (odd) {
+            status |= bigAdd(&c, &c, &d);       // F(2k + 2)
+            bigSwap(&a, &d);
+            bigSwap(&b, &c);
+        } else {
+            bigSwap(&a, &c);
+            bigSwap(&b, &d);
+        }
+    }
+
+    if (status == 0) bigSwap(result, &a);
+    bigFree(&a); bigFree(&b); bigFree(&t); bigFree(&c); bigFree(&d);
+    return status == 0 ? 0 : -1;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+// The original double recursion, kept for comparison
+static int fibonacciRecursive(int n) {
     if (n == 0)  // Base case
         return 0;
     else if (n == 1)
         return 1;
     else
-        return fibonacci(n - 1) + fibonacci(n - 2);  // Recursive call
+        return fibonacciRecursive(n - 1) + fibonacciRecursive(n - 2);  // Recursive call
+}
+
+// n big additions: O(n^2) limb operations
+static int fibonacciIterative(unsigned n, struct BigNum* result) {
+    struct BigNum a, b;
+    bigInit(&a);
+    bigInit(&b);
+    int status = bigSetU64(&a, 0) | bigSetU64(&b, 1);
+    for (unsigned i = 0; i < n && status == 0; i++) {
+        status |= bigAdd(&a, &a, &b);
+        bigSwap(&a, &b);
+    }
+    bigSwap(result, &a);
+    bigFree(&a);
+    bigFree(&b);
+    return status;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define ITERATIVE_LIMIT 100000  // The O(n^2) baseline gets slow past this
+
+static void runBenchmark(void) {
+    unsigned sizes[] = {1000, 100000, 1000000};
+    double t0 = nowSeconds();
+    int naive = fibonacciRecursive(35);
+    printf("Naive recursion, F(35) = %d: %.3f s\n\n", naive, nowSeconds() - t0);
+
+    printf("%10s %12s %16s %16s\n", "n", "bits", "fast doubling s", "iterative s");
+    for (int s = 0; s < 3; s++) {
+        unsigned n = sizes[s];
+        struct BigNum fast, slow;
+        bigInit(&fast);
+        bigInit(&slow);
+
+        // Repeat short runs so the timer has something to measure
+        int reps = n <= 1000 ? 1000 : 1;
+        t0 = nowSeconds();
+        for (int r = 0; r < reps; r++) fibonacci(n, &fast);
+        double fastTime = (nowSeconds() - t0) / reps;
+
+        if (n <= ITERATIVE_LIMIT) {
+            t0 = nowSeconds();
+            fibonacciIterative(n, &slow);
+            double slowTime = nowSeconds() - t0;
+            int same = fast.length == slow.length &&
+                       memcmp(fast.limbs, slow.limbs, fast.length * sizeof(uint32_t)) == 0;
+            printf("%10u %12zu %16.6f %16.6f%s\n", n, bigBitLength(&fast), fastTime, slowTime,
+                   same ? "" : "  (results differ)");
+        } else {
+            printf("%10u %12zu %16.6f %16s\n", n, bigBitLength(&fast), fastTime, "skipped");
+        }
+        bigFree(&fast);
+        bigFree(&slow);
+    }
 }
 
-int main() {
-    printf("%d\n", fibonacci(5));  // Output: 5
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark();
+        return 0;
+    }
+
+    uint64_t small;
+    fibonacci_u64(5, &small);
+    printf("%llu\n", (unsigned long long)small);  // Output: 5
+
+    if (fibonacci_u64(94, &small) != 0) {
+        printf("F(94) does not fit in 64 bits\n");
+    }
+
+    struct BigNum f;
+    bigInit(&f);
+    fibonacci(100, &f);
+    char* text = bigToDecimal(&f);
+    printf("F(100) = %s\n", text);  // 354224848179261915075
+    free(text);
+
+    fibonacci(1000, &f);
+    text = bigToDecimal(&f);
+    printf("F(1000) has %zu digits: %.20s...\n", strlen(text), text);
+    free(text);
+
+    bigFree(&f);
     return 0;
 }
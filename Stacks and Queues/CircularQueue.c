@@ -1,103 +1,487 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
 
-#define SIZE 5  // Define the maximum size of the queue
+#define CACHE_LINE 64  // Head and tail live on separate cache lines to avoid false sharing
 
-// Circular Queue structure
-struct CircularQueue {
-    int items[SIZE];
-    int front;
-    int rear;
+// Round a requested capacity up to the next power of two so that
+// "index % capacity" can be computed as "index & mask"
+static size_t roundUpPowerOfTwo(size_t n) {
+    size_t capacity = 2;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// ---------------------------------------------------------------------------
+// Single-producer / single-consumer ring
+// ---------------------------------------------------------------------------
+
+// head and tail are free-running counters; the slot is counter & mask.
+// Each side also keeps a cached copy of the other side's counter so it only
+// touches the shared cache line when the ring looks full or empty.
+struct SPSCQueue {
+    _Alignas(CACHE_LINE) atomic_size_t tail;  // Written by the producer
+    size_t cachedHead;                        // Producer's view of head
+    _Alignas(CACHE_LINE) atomic_size_t head;  // Written by the consumer
+    size_t cachedTail;                        // Consumer's view of tail
+    _Alignas(CACHE_LINE) size_t mask;
+    int* items;
 };
 
-// Initialize the queue by setting front and rear to -1
-void initializeQueue(struct CircularQueue* cq) {
-    cq->front = -1;
-    cq->rear = -1;
-}
-
-// Check if the queue is full
-int isFull(struct CircularQueue* cq) {
-    return (cq->front == (cq->rear + 1) % SIZE);
-}
-
-// Check if the queue is empty
-int isEmpty(struct CircularQueue* cq) {
-    return (cq->front == -1);
-}
-
-// Enqueue operation to insert an element into the queue
-void enqueue(struct CircularQueue* cq, int value) {
-    if (isFull(cq)) {
-        printf("Queue is full!\n");
-    } else {
-        // If inserting the first element, set front = 0
-        if (cq->front == -1)
-            cq->front = 0;
-        
-        // Update rear to the next position in a circular way
-        cq->rear = (cq->rear + 1) % SIZE;
-        cq->items[cq->rear] = value;
-        printf("Inserted %d\n", value);
-    }
-}
-
-// Dequeue operation to remove an element from the queue
-int dequeue(struct CircularQueue* cq) {
-    int element;
-    if (isEmpty(cq)) {
-        printf("Queue is empty!\n");
-        return -1;
-    } else {
-        element = cq->items[cq->front];  // Get the front element
-        
-        // If the queue has only one element, reset to empty
-        if (cq->front == cq->rear) {
-            cq->front = -1;
-            cq->rear = -1;
+// Initialize the ring with room for at least `capacity` elements
+int spsc_init(struct SPSCQueue* q, size_t capacity) {
+    capacity = roundUpPowerOfTwo(capacity);
+    q->items = (int*)malloc(capacity * sizeof(int));
+    if (q->items == NULL) return -1;
+    q->mask = capacity - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->cachedHead = 0;
+    q->cachedTail = 0;
+    return 0;
+}
+
+void spsc_destroy(struct SPSCQueue* q) {
+    free(q->items);
+    q->items = NULL;
+}
+
+// Enqueue up to n values, returns how many were written (0 if the ring is full)
+size_t spsc_enqueue_n(struct SPSCQueue* q, const int* values, size_t n) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t capacity = q->mask + 1;
+    size_t space = capacity - (tail - q->cachedHead);
+    if (space < n) {
+        q->cachedHead = atomic_load_explicit(&q->head, memory_order_acquire);
+        space = capacity - (tail - q->cachedHead);
+        if (n > space) n = space;
+    }
+    if (n == 0) return 0;
+
+    // Copy in at most two contiguous pieces (before and after the wrap point)
+    size_t start = tail & q->mask;
+    size_t first = capacity - start;
+    if (first > n) first = n;
+    memcpy(q->items + start, values, first * sizeof(int));
+    memcpy(q->items, values + first, (n - first) * sizeof(int));
+
+    atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+    return n;
+}
+
+// Dequeue up to n values into out, returns how many were read (0 if the ring is empty)
+size_t spsc_dequeue_n(struct SPSCQueue* q, int* out, size_t n) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t available = q->cachedTail - head;
+    if (available < n) {
+        q->cachedTail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        available = q->cachedTail - head;
+        if (n > available) n = available;
+    }
+    if (n == 0) return 0;
+
+    size_t capacity = q->mask + 1;
+    size_t start = head & q->mask;
+    size_t first = capacity - start;
+    if (first > n) first = n;
+    memcpy(out, q->items + start, first * sizeof(int));
+    memcpy(out + first, q->items, (n - first) * sizeof(int));
+
+    atomic_store_explicit(&q->head, head + n, memory_order_release);
+    return n;
+}
+
+// Enqueue one value, returns 1 on success and 0 if the ring is full
+int spsc_enqueue(struct SPSCQueue* q, int value) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - q->cachedHead > q->mask) {
+        q->cachedHead = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail - q->cachedHead > q->mask) return 0;
+    }
+    q->items[tail & q->mask] = value;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+// Dequeue one value, returns 1 on success and 0 if the ring is empty
+int spsc_dequeue(struct SPSCQueue* q, int* value) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == q->cachedTail) {
+        q->cachedTail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head == q->cachedTail) return 0;
+    }
+    *value = q->items[head & q->mask];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Multi-producer / multi-consumer ring (Dmitry Vyukov's bounded queue)
+// ---------------------------------------------------------------------------
+
+// Every cell carries a sequence number telling whose turn it is:
+//   sequence == pos      -> free, the producer that claims pos may write it
+//   sequence == pos + 1  -> full, the consumer that claims pos may read it
+struct MPMCCell {
+    atomic_size_t sequence;
+    int value;
+};
+
+struct MPMCQueue {
+    _Alignas(CACHE_LINE) atomic_size_t enqueuePos;
+    _Alignas(CACHE_LINE) atomic_size_t dequeuePos;
+    _Alignas(CACHE_LINE) size_t mask;
+    struct MPMCCell* cells;
+};
+
+int mpmc_init(struct MPMCQueue* q, size_t capacity) {
+    capacity = roundUpPowerOfTwo(capacity);
+    q->cells = (struct MPMCCell*)malloc(capacity * sizeof(struct MPMCCell));
+    if (q->cells == NULL) return -1;
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&q->cells[i].sequence, i);
+    }
+    q->mask = capacity - 1;
+    atomic_init(&q->enqueuePos, 0);
+    atomic_init(&q->dequeuePos, 0);
+    return 0;
+}
+
+void mpmc_destroy(struct MPMCQueue* q) {
+    free(q->cells);
+    q->cells = NULL;
+}
+
+// Enqueue one value, returns 1 on success and 0 if the ring is full
+int mpmc_enqueue(struct MPMCQueue* q, int value) {
+    size_t pos = atomic_load_explicit(&q->enqueuePos, memory_order_relaxed);
+    struct MPMCCell* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        long diff = (long)seq - (long)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueuePos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return 0;  // The cell still holds an element from the previous lap
         } else {
-            // Move front to the next position in a circular way
-            cq->front = (cq->front + 1) % SIZE;
+            pos = atomic_load_explicit(&q->enqueuePos, memory_order_relaxed);
+        }
+    }
+    cell->value = value;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return 1;
+}
+
+// Dequeue one value, returns 1 on success and 0 if the ring is empty
+int mpmc_dequeue(struct MPMCQueue* q, int* value) {
+    size_t pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+    struct MPMCCell* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        long diff = (long)seq - (long)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeuePos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return 0;  // Nothing has been published in this cell yet
+        } else {
+            pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+        }
+    }
+    *value = cell->value;
+    atomic_store_explicit(&cell->sequence, pos + q->mask + 1, memory_order_release);
+    return 1;
+}
+
+// Enqueue up to n values with a single CAS on enqueuePos.
+// Returns how many were written (0 if the ring is full).
+size_t mpmc_enqueue_n(struct MPMCQueue* q, const int* values, size_t n) {
+    size_t pos = atomic_load_explicit(&q->enqueuePos, memory_order_relaxed);
+    size_t count;
+    for (;;) {
+        // Count how many consecutive cells starting at pos are free for this lap
+        count = 0;
+        while (count < n) {
+            size_t seq = atomic_load_explicit(&q->cells[(pos + count) & q->mask].sequence,
+                                              memory_order_acquire);
+            if (seq != pos + count) break;
+            count++;
+        }
+        if (count == 0) {
+            size_t seq = atomic_load_explicit(&q->cells[pos & q->mask].sequence, memory_order_acquire);
+            if ((long)seq - (long)pos < 0) return 0;
+            pos = atomic_load_explicit(&q->enqueuePos, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&q->enqueuePos, &pos, pos + count,
+                                                  memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+    // The claimed cells belong to this producer until their sequence is published
+    for (size_t i = 0; i < count; i++) {
+        struct MPMCCell* cell = &q->cells[(pos + i) & q->mask];
+        cell->value = values[i];
+        atomic_store_explicit(&cell->sequence, pos + i + 1, memory_order_release);
+    }
+    return count;
+}
+
+// Dequeue up to n values with a single CAS on dequeuePos.
+// Returns how many were read (0 if the ring is empty).
+size_t mpmc_dequeue_n(struct MPMCQueue* q, int* out, size_t n) {
+    size_t pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+    size_t count;
+    for (;;) {
+        // Count how many consecutive cells starting at pos have been published
+        count = 0;
+        while (count < n) {
+            size_t seq = atomic_load_explicit(&q->cells[(pos + count) & q->mask].sequence,
+                                              memory_order_acquire);
+            if (seq != pos + count + 1) break;
+            count++;
+        }
+        if (count == 0) {
+            size_t seq = atomic_load_explicit(&q->cells[pos & q->mask].sequence, memory_order_acquire);
+            if ((long)seq - (long)(pos + 1) < 0) return 0;
+            pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&q->dequeuePos, &pos, pos + count,
+                                                  memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+    for (size_t i = 0; i < count; i++) {
+        struct MPMCCell* cell = &q->cells[(pos + i) & q->mask];
+        out[i] = cell->value;
+        atomic_store_explicit(&cell->sequence, pos + i + q->mask + 1, memory_order_release);
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: throughput with multiple threads against a mutex-protected ring
+// ---------------------------------------------------------------------------
+
+// The previous approach: a modulo-indexed ring behind one lock
+struct LockedQueue {
+    pthread_mutex_t lock;
+    int* items;
+    size_t capacity;
+    size_t front;
+    size_t count;
+};
+
+static int lockedEnqueue(struct LockedQueue* q, int value) {
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->count < q->capacity) {
+        q->items[(q->front + q->count) % q->capacity] = value;
+        q->count++;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+static int lockedDequeue(struct LockedQueue* q, int* value) {
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->count > 0) {
+        *value = q->items[q->front];
+        q->front = (q->front + 1) % q->capacity;
+        q->count--;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+enum QueueKind { KIND_LOCKED, KIND_SPSC, KIND_MPMC };
+
+#define BENCH_CAPACITY 4096
+#define BENCH_BATCH 32
+
+struct BenchShared {
+    enum QueueKind kind;
+    int batched;
+    void* queue;
+    long itemsPerProducer;
+    long itemsPerConsumer;
+    atomic_llong sum;
+};
+
+static void* producerThread(void* arg) {
+    struct BenchShared* b = (struct BenchShared*)arg;
+    int batch[BENCH_BATCH];
+    long sent = 0;
+    while (sent < b->itemsPerProducer) {
+        size_t n = 1;
+        if (b->batched) {
+            n = BENCH_BATCH;
+            if ((long)n > b->itemsPerProducer - sent) n = (size_t)(b->itemsPerProducer - sent);
+            for (size_t i = 0; i < n; i++) batch[i] = (int)(sent + i);
+        }
+        size_t done;
+        switch (b->kind) {
+            case KIND_LOCKED: done = (size_t)lockedEnqueue(b->queue, (int)sent); break;
+            case KIND_SPSC:
+                done = b->batched ? spsc_enqueue_n(b->queue, batch, n)
+                                  : (size_t)spsc_enqueue(b->queue, (int)sent);
+                break;
+            default:
+                done = b->batched ? mpmc_enqueue_n(b->queue, batch, n)
+                                  : (size_t)mpmc_enqueue(b->queue, (int)sent);
+                break;
         }
-        printf("Deleted %d\n", element);
-        return element;
+        if (done == 0) sched_yield();
+        sent += (long)done;
     }
+    return NULL;
 }
 
-// Function to display the queue
-void display(struct CircularQueue* cq) {
-    if (isEmpty(cq)) {
-        printf("Queue is empty!\n");
-    } else {
-        int i = cq->front;
-        printf("Queue elements: ");
-        while (i != cq->rear) {
-            printf("%d ", cq->items[i]);
-            i = (i + 1) % SIZE;
+static void* consumerThread(void* arg) {
+    struct BenchShared* b = (struct BenchShared*)arg;
+    int batch[BENCH_BATCH];
+    long received = 0;
+    long long sum = 0;
+    while (received < b->itemsPerConsumer) {
+        size_t n = b->batched ? BENCH_BATCH : 1;
+        if ((long)n > b->itemsPerConsumer - received) n = (size_t)(b->itemsPerConsumer - received);
+        size_t done;
+        switch (b->kind) {
+            case KIND_LOCKED: done = (size_t)lockedDequeue(b->queue, batch); break;
+            case KIND_SPSC:
+                done = b->batched ? spsc_dequeue_n(b->queue, batch, n)
+                                  : (size_t)spsc_dequeue(b->queue, batch);
+                break;
+            default:
+                done = b->batched ? mpmc_dequeue_n(b->queue, batch, n)
+                                  : (size_t)mpmc_dequeue(b->queue, batch);
+                break;
         }
-        printf("%d\n", cq->items[i]);  // Print the last element (rear)
-    }
-}
-
-int main() {
-    struct CircularQueue cq;
-    initializeQueue(&cq);
-
-    enqueue(&cq, 10);
-    enqueue(&cq, 20);
-    enqueue(&cq, 30);
-    enqueue(&cq, 40);
-    enqueue(&cq, 50);  // This will fill the queue
-    
-    display(&cq);  // Display the queue
-    
-    dequeue(&cq);  // Remove element
-    dequeue(&cq);  // Remove element
-    
-    display(&cq);  // Display the queue after deletion
-    
-    enqueue(&cq, 60);  // Add new element
-    display(&cq);  // Display the updated queue
+        if (done == 0) sched_yield();
+        for (size_t i = 0; i < done; i++) sum += batch[i];
+        received += (long)done;
+    }
+    atomic_fetch_add(&b->sum, sum);
+    return NULL;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Moves `total` items from `producers` threads to `consumers` threads; returns items/sec
+static double runQueueBench(enum QueueKind kind, int batched, int producers, int consumers, long total) {
+    struct LockedQueue locked;
+    struct SPSCQueue spsc;
+    struct MPMCQueue mpmc;
+    struct BenchShared b;
+    pthread_t threads[64];
+
+    // Every producer sends 0..itemsPerProducer-1, so the expected sum is known up front
+    total -= total % ((long)producers * consumers);
+    b.kind = kind;
+    b.batched = batched;
+    b.itemsPerProducer = total / producers;
+    b.itemsPerConsumer = total / consumers;
+    atomic_init(&b.sum, 0);
+    switch (kind) {
+        case KIND_LOCKED:
+            pthread_mutex_init(&locked.lock, NULL);
+            locked.capacity = BENCH_CAPACITY;
+            locked.items = (int*)malloc(BENCH_CAPACITY * sizeof(int));
+            locked.front = locked.count = 0;
+            b.queue = &locked;
+            break;
+        case KIND_SPSC: spsc_init(&spsc, BENCH_CAPACITY); b.queue = &spsc; break;
+        default: mpmc_init(&mpmc, BENCH_CAPACITY); b.queue = &mpmc; break;
+    }
+
+    double start = nowSeconds();
+    for (int i = 0; i < consumers; i++) pthread_create(&threads[i], NULL, consumerThread, &b);
+    for (int i = 0; i < producers; i++) pthread_create(&threads[consumers + i], NULL, producerThread, &b);
+    for (int i = 0; i < producers + consumers; i++) pthread_join(threads[i], NULL);
+    double elapsed = nowSeconds() - start;
+
+    long long expected = (long long)producers * b.itemsPerProducer * (b.itemsPerProducer - 1) / 2;
+    if (atomic_load(&b.sum) != expected) printf("checksum mismatch\n");
+
+    switch (kind) {
+        case KIND_LOCKED: pthread_mutex_destroy(&locked.lock); free(locked.items); break;
+        case KIND_SPSC: spsc_destroy(&spsc); break;
+        default: mpmc_destroy(&mpmc); break;
+    }
+    return total / elapsed;
+}
+
+static void runBenchmark(long total) {
+    printf("%-24s %8s %14s\n", "queue", "threads", "items/sec");
+    printf("%-24s %8s %14.0f\n", "mutex ring", "1P/1C", runQueueBench(KIND_LOCKED, 0, 1, 1, total));
+    printf("%-24s %8s %14.0f\n", "spsc", "1P/1C", runQueueBench(KIND_SPSC, 0, 1, 1, total));
+    printf("%-24s %8s %14.0f\n", "spsc enqueue_n/dequeue_n", "1P/1C", runQueueBench(KIND_SPSC, 1, 1, 1, total));
+    int counts[] = {1, 2, 4};
+    for (int i = 0; i < 3; i++) {
+        char label[16];
+        int t = counts[i];
+        snprintf(label, sizeof(label), "%dP/%dC", t, t);
+        printf("%-24s %8s %14.0f\n", "mutex ring", label, runQueueBench(KIND_LOCKED, 0, t, t, total));
+        printf("%-24s %8s %14.0f\n", "mpmc", label, runQueueBench(KIND_MPMC, 0, t, t, total));
+        printf("%-24s %8s %14.0f\n", "mpmc enqueue_n/dequeue_n", label, runQueueBench(KIND_MPMC, 1, t, t, total));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        long total = argc > 2 ? atol(argv[2]) : 10000000;
+        runBenchmark(total);
+        return 0;
+    }
+
+    struct SPSCQueue spsc;
+    struct MPMCQueue mpmc;
+    int value;
+
+    spsc_init(&spsc, 5);  // Rounded up to a capacity of 8
+    for (int i = 1; i <= 9; i++) {
+        if (!spsc_enqueue(&spsc, i * 10)) {
+            printf("Queue is full! (%d not inserted)\n", i * 10);
+        }
+    }
+    spsc_dequeue(&spsc, &value);
+    printf("Deleted %d\n", value);
+    spsc_dequeue(&spsc, &value);
+    printf("Deleted %d\n", value);
+
+    int batch[] = {100, 110, 120};
+    printf("Batch inserted %zu elements\n", spsc_enqueue_n(&spsc, batch, 3));
+    int out[8];
+    size_t n = spsc_dequeue_n(&spsc, out, 8);
+    printf("Queue elements: ");
+    for (size_t i = 0; i < n; i++) printf("%d ", out[i]);
+    printf("\n");
+    spsc_destroy(&spsc);
+
+    mpmc_init(&mpmc, 4);
+    mpmc_enqueue(&mpmc, 1);
+    mpmc_enqueue_n(&mpmc, batch, 3);
+    printf("MPMC queue elements: ");
+    while (mpmc_dequeue(&mpmc, &value)) printf("%d ", value);
+    printf("\n");
+    mpmc_destroy(&mpmc);
 
     return 0;
 }
@@ -1,94 +1,275 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
 
-#define MAX 5  // Maximum size of the deque
+#define BLOCK_SHIFT 10
+#define BLOCK_SIZE (1 << BLOCK_SHIFT)  // Elements per block
+#define BLOCK_MASK (BLOCK_SIZE - 1)
+#define INITIAL_MAP_SIZE 8             // Block slots in a new map, a power of two
 
+// Status codes returned by the deque functions
+#define DEQUE_OK 0
+#define DEQUE_EMPTY -1      // Nothing to remove or read (or index out of range)
+#define DEQUE_NO_MEMORY -2  // A block or a larger map could not be allocated
+
+// Block-map deque (the layout std::deque uses): elements live in fixed-size
+// blocks, and a circular map holds pointers to the blocks. Positions are
+// 64-bit counters: element i sits at position front + i, in block
+// (position >> BLOCK_SHIFT) and slot (position & BLOCK_MASK). Growing only
+// reallocates the map of block pointers; elements are never moved.
 typedef struct {
-    int arr[MAX];
-    int front;
-    int rear;
-    int size;
+    int** map;          // Ring of block pointers, NULL where no block is in use
+    uint64_t mapMask;   // Map size - 1
+    uint64_t front;     // Position of the first element
+    uint64_t rear;      // Position one past the last element
+    int* spare;         // One released block kept for reuse
 } Deque;
 
 // Initialize deque
-void initDeque(Deque *dq) {
-    dq->front = -1;
-    dq->rear = 0;
-    dq->size = 0;
+int initDeque(Deque *dq) {
+    dq->map = (int**)calloc(INITIAL_MAP_SIZE, sizeof(int*));
+    dq->mapMask = INITIAL_MAP_SIZE - 1;
+    // Start in the middle of the position space so both ends have room to move
+    dq->front = dq->rear = (uint64_t)1 << 62;
+    dq->spare = NULL;
+    return dq->map != NULL ? DEQUE_OK : DEQUE_NO_MEMORY;
 }
 
-// Check if deque is full
-int isFull(Deque *dq) {
-    return dq->size == MAX;
+// Free every block and the map
+void destroyDeque(Deque *dq) {
+    if (dq->front != dq->rear) {
+        for (uint64_t b = dq->front >> BLOCK_SHIFT; b <= (dq->rear - 1) >> BLOCK_SHIFT; b++) {
+            free(dq->map[b & dq->mapMask]);
+        }
+    }
+    free(dq->spare);
+    free(dq->map);
+    dq->map = NULL;
+    dq->spare = NULL;
 }
 
 // Check if deque is empty
 int isEmpty(Deque *dq) {
-    return dq->size == 0;
+    return dq->front == dq->rear;
+}
+
+uint64_t size(Deque *dq) {
+    return dq->rear - dq->front;
+}
+
+// Double the map until `blocks` blocks fit. Block b always sits in slot
+// b & mapMask, so the pointers are re-slotted for the new mask.
+static int growMap(Deque *dq, uint64_t blocks) {
+    uint64_t newSize = dq->mapMask + 1;
+    while (newSize < blocks) {
+        newSize *= 2;
+    }
+    int** map = (int**)calloc(newSize, sizeof(int*));
+    if (map == NULL) return DEQUE_NO_MEMORY;
+    if (!isEmpty(dq)) {
+        for (uint64_t b = dq->front >> BLOCK_SHIFT; b <= (dq->rear - 1) >> BLOCK_SHIFT; b++) {
+            map[b & (newSize - 1)] = dq->map[b & dq->mapMask];
+        }
+    }
+    free(dq->map);
+    dq->map = map;
+    dq->mapMask = newSize - 1;
+    return DEQUE_OK;
+}
+
+// Install a block for block number b; `blocks` is how many blocks will be in use
+static int addBlock(Deque *dq, uint64_t b, uint64_t blocks) {
+    if (blocks > dq->mapMask + 1 && growMap(dq, blocks) != DEQUE_OK) {
+        return DEQUE_NO_MEMORY;
+    }
+    int* block = dq->spare;
+    if (block != NULL) {
+        dq->spare = NULL;
+    } else {
+        block = (int*)malloc(BLOCK_SIZE * sizeof(int));
+        if (block == NULL) return DEQUE_NO_MEMORY;
+    }
+    dq->map[b & dq->mapMask] = block;
+    return DEQUE_OK;
+}
+
+// Take block number b out of the map once no element uses it
+static void releaseBlock(Deque *dq, uint64_t b) {
+    int** slot = &dq->map[b & dq->mapMask];
+    if (dq->spare == NULL) {
+        dq->spare = *slot;
+    } else {
+        free(*slot);
+    }
+    *slot = NULL;
 }
 
 // Insert element at the rear
-void insertRear(Deque *dq, int key) {
-    if (isFull(dq)) {
-        printf("Deque is full\n");
-        return;
+int insertRear(Deque *dq, int key) {
+    uint64_t pos = dq->rear;
+    // A new block is needed when the deque is empty or rear starts a fresh block
+    if (isEmpty(dq) || (pos & BLOCK_MASK) == 0) {
+        uint64_t blocks = isEmpty(dq) ? 1 : (pos >> BLOCK_SHIFT) - (dq->front >> BLOCK_SHIFT) + 1;
+        if (addBlock(dq, pos >> BLOCK_SHIFT, blocks) != DEQUE_OK) return DEQUE_NO_MEMORY;
     }
-    dq->rear = (dq->rear + 1) % MAX;
-    dq->arr[dq->rear] = key;
-    dq->size++;
+    dq->map[(pos >> BLOCK_SHIFT) & dq->mapMask][pos & BLOCK_MASK] = key;
+    dq->rear = pos + 1;
+    return DEQUE_OK;
 }
 
 // Insert element at the front
-void insertFront(Deque *dq, int key) {
-    if (isFull(dq)) {
-        printf("Deque is full\n");
-        return;
+int insertFront(Deque *dq, int key) {
+    uint64_t pos = dq->front - 1;
+    // A new block is needed when the deque is empty or front leaves its block
+    if (isEmpty(dq) || (pos & BLOCK_MASK) == BLOCK_MASK) {
+        uint64_t blocks = isEmpty(dq) ? 1 : ((dq->rear - 1) >> BLOCK_SHIFT) - (pos >> BLOCK_SHIFT) + 1;
+        if (addBlock(dq, pos >> BLOCK_SHIFT, blocks) != DEQUE_OK) return DEQUE_NO_MEMORY;
+        if (isEmpty(dq)) dq->rear = pos + 1;
     }
-    dq->front = (dq->front - 1 + MAX) % MAX;
-    dq->arr[dq->front] = key;
-    dq->size++;
+    dq->map[(pos >> BLOCK_SHIFT) & dq->mapMask][pos & BLOCK_MASK] = key;
+    dq->front = pos;
+    return DEQUE_OK;
 }
 
 // Delete element from the front
-void deleteFront(Deque *dq) {
+int deleteFront(Deque *dq) {
     if (isEmpty(dq)) {
-        printf("Deque is empty\n");
-        return;
+        return DEQUE_EMPTY;
     }
-    dq->front = (dq->front + 1) % MAX;
-    dq->size--;
+    uint64_t pos = dq->front++;
+    if (isEmpty(dq) || (dq->front & BLOCK_MASK) == 0) {
+        releaseBlock(dq, pos >> BLOCK_SHIFT);
+    }
+    return DEQUE_OK;
 }
 
 // Delete element from the rear
-void deleteRear(Deque *dq) {
+int deleteRear(Deque *dq) {
     if (isEmpty(dq)) {
-        printf("Deque is empty\n");
-        return;
+        return DEQUE_EMPTY;
+    }
+    uint64_t pos = --dq->rear;
+    if (isEmpty(dq) || (pos & BLOCK_MASK) == 0) {
+        releaseBlock(dq, pos >> BLOCK_SHIFT);
     }
-    dq->rear = (dq->rear - 1 + MAX) % MAX;
-    dq->size--;
+    return DEQUE_OK;
 }
 
-// Get the front element
-int getFront(Deque *dq) {
-    if (isEmpty(dq)) {
-        printf("Deque is empty\n");
-        return -1;
+// Get the element at index i (0 is the front) in O(1)
+int getAt(Deque *dq, uint64_t i, int *value) {
+    if (i >= size(dq)) {
+        return DEQUE_EMPTY;
     }
-    return dq->arr[dq->front];
+    uint64_t pos = dq->front + i;
+    *value = dq->map[(pos >> BLOCK_SHIFT) & dq->mapMask][pos & BLOCK_MASK];
+    return DEQUE_OK;
+}
+
+// Get the front element
+int getFront(Deque *dq, int *value) {
+    return getAt(dq, 0, value);
 }
 
 // Get the rear element
-int getRear(Deque *dq) {
-    if (isEmpty(dq)) {
-        printf("Deque is empty\n");
-        return -1;
+int getRear(Deque *dq, int *value) {
+    return getAt(dq, size(dq) - 1, value);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks: both-end churn and random access
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void runBenchmark(int n) {
+    Deque dq;
+    int value = 0;
+    long long sum = 0;
+    initDeque(&dq);
+
+    // Grow to n elements, half at each end
+    double t0 = nowSeconds();
+    for (int i = 0; i < n / 2; i++) {
+        insertRear(&dq, i);
+        insertFront(&dq, -i);
+    }
+    double fill = nowSeconds() - t0;
+
+    // Sliding window: push at one end, pop at the other, in both directions
+    long long churnOps = 4LL * n;
+    t0 = nowSeconds();
+    for (long long i = 0; i < churnOps / 4; i++) {
+        insertRear(&dq, (int)i);
+        deleteFront(&dq);
+    }
+    for (long long i = 0; i < churnOps / 4; i++) {
+        insertFront(&dq, (int)i);
+        deleteRear(&dq);
     }
-    return dq->arr[dq->rear];
+    double churn = nowSeconds() - t0;
+
+    // Random reads against a plain array of the same size
+    int* array = (int*)malloc((size_t)n * sizeof(int));
+    for (uint64_t i = 0; i < size(&dq); i++) {
+        getAt(&dq, i, &array[i]);
+    }
+    int reads = 20000000;
+    uint64_t seed = 88172645463325252ULL;
+    t0 = nowSeconds();
+    for (int i = 0; i < reads; i++) {
+        getAt(&dq, nextRandom(&seed) % size(&dq), &value);
+        sum += value;
+    }
+    double dequeRead = nowSeconds() - t0;
+    seed = 88172645463325252ULL;
+    t0 = nowSeconds();
+    for (int i = 0; i < reads; i++) {
+        sum -= array[nextRandom(&seed) % size(&dq)];
+    }
+    double arrayRead = nowSeconds() - t0;
+    if (sum != 0) printf("checksum mismatch\n");
+
+    // Drain from both ends
+    t0 = nowSeconds();
+    while (!isEmpty(&dq)) {
+        deleteFront(&dq);
+        deleteRear(&dq);
+    }
+    double drain = nowSeconds() - t0;
+
+    printf("%d elements, %d-element blocks\n", n, BLOCK_SIZE);
+    printf("%-28s %16s\n", "operation", "ops/sec");
+    printf("%-28s %16.0f\n", "fill (push both ends)", n / fill);
+    printf("%-28s %16.0f\n", "churn (push one, pop other)", churnOps / churn);
+    printf("%-28s %16.0f\n", "random getAt", reads / dequeRead);
+    printf("%-28s %16.0f\n", "random read, plain array", reads / arrayRead);
+    printf("%-28s %16.0f\n", "drain (pop both ends)", n / drain);
+
+    free(array);
+    destroyDeque(&dq);
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+
     Deque dq;
+    int value = 0;
     initDeque(&dq);
 
     insertRear(&dq, 10);
@@ -96,15 +277,28 @@ int main() {
     insertFront(&dq, 30);
     insertFront(&dq, 40);
 
-    printf("Front element: %d\n", getFront(&dq));  // Should be 40
-    printf("Rear element: %d\n", getRear(&dq));    // Should be 20
+    getFront(&dq, &value);
+    printf("Front element: %d\n", value);  // Should be 40
+    getRear(&dq, &value);
+    printf("Rear element: %d\n", value);   // Should be 20
 
     deleteFront(&dq);
     deleteRear(&dq);
 
     printf("After deletions:\n");
-    printf("Front element: %d\n", getFront(&dq));  // Should be 30
-    printf("Rear element: %d\n", getRear(&dq));    // Should be 10
+    getFront(&dq, &value);
+    printf("Front element: %d\n", value);  // Should be 30
+    getRear(&dq, &value);
+    printf("Rear element: %d\n", value);   // Should be 10
+
+    // Grow well past a single block at both ends
+    for (int i = 0; i < 5000; i++) {
+        insertRear(&dq, i);
+        insertFront(&dq, -i);
+    }
+    getAt(&dq, 5000, &value);
+    printf("Size %llu, element at index 5000: %d\n", (unsigned long long)size(&dq), value);
 
+    destroyDeque(&dq);
     return 0;
 }
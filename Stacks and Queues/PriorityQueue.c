@@ -1,23 +1,77 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
 
-#define SIZE 5  // Define the maximum size of the priority queue
+#define INITIAL_CAPACITY 16  // Starting size of the heap, doubled on demand
+#define DEFAULT_ARITY 4      // Children per node: 2, 4 or 8
 
-// Structure to store elements and their priorities
+// One element in the heap. The handle lets callers refer to the element
+// later (for decreaseKey) even though its position keeps changing.
+struct PQEntry {
+    int item;
+    int priority;
+    int handle;         // Handle slot, the low half of the caller's PQHandle
+};
+
+// Handed out by enqueue: the slot in the low 32 bits and the slot's
+// generation in the high 32. A slot is reused after dequeue, but with a new
+// generation, so a handle to an element that has left the queue is detected
+// instead of reaching whichever element got the slot next.
+typedef uint64_t PQHandle;  // 0 is never a valid handle
+
+// Growable d-ary max-heap: the element with the highest priority is at index 0.
+// The children of index i live at (i << arityShift) + 1 ... + arity.
 struct PriorityQueue {
-    int items[SIZE];
-    int priorities[SIZE];
+    struct PQEntry* entries;
+    int* position;         // position[handle] = index of that handle in entries
+    uint32_t* generation;  // generation[handle] = generation of that slot, see PQHandle
+    int* freeHandles;      // Stack of handles released by dequeue
+    int freeCount;
+    int nextHandle;        // Next never-used handle
     int count;
+    int capacity;
+    int arityShift;        // log2(arity)
 };
 
-// Initialize the priority queue
-void initializeQueue(struct PriorityQueue* pq) {
-    pq->count = 0;  // Set initial count to 0
+// Initialize the priority queue with the given arity (2, 4 or 8)
+int initializeQueue(struct PriorityQueue* pq, int arity) {
+    switch (arity) {
+        case 2: pq->arityShift = 1; break;
+        case 4: pq->arityShift = 2; break;
+        case 8: pq->arityShift = 3; break;
+        default: return -1;
+    }
+    pq->count = 0;
+    pq->freeCount = 0;
+    pq->nextHandle = 0;
+    pq->capacity = INITIAL_CAPACITY;
+    pq->entries = (struct PQEntry*)malloc(pq->capacity * sizeof(struct PQEntry));
+    pq->position = (int*)malloc(pq->capacity * sizeof(int));
+    pq->freeHandles = (int*)malloc(pq->capacity * sizeof(int));
+    pq->generation = (uint32_t*)malloc(pq->capacity * sizeof(uint32_t));
+    if (pq->entries == NULL || pq->position == NULL || pq->freeHandles == NULL || pq->generation == NULL) {
+        free(pq->entries);
+        free(pq->position);
+        free(pq->freeHandles);
+        free(pq->generation);
+        return -1;
+    }
+    return 0;
 }
 
-// Check if the priority queue is full
-int isFull(struct PriorityQueue* pq) {
-    return pq->count == SIZE;
+// Release the memory held by the queue
+void destroyQueue(struct PriorityQueue* pq) {
+    free(pq->entries);
+    free(pq->position);
+    free(pq->freeHandles);
+    free(pq->generation);
+    pq->entries = NULL;
+    pq->position = NULL;
+    pq->freeHandles = NULL;
+    pq->generation = NULL;
+    pq->count = pq->capacity = 0;
 }
 
 // Check if the priority queue is empty
@@ -25,24 +79,97 @@ int isEmpty(struct PriorityQueue* pq) {
     return pq->count == 0;
 }
 
-// Enqueue operation with priority
-void enqueue(struct PriorityQueue* pq, int value, int priority) {
-    if (isFull(pq)) {
-        printf("Queue is full!\n");
-        return;
+// Make room for at least `needed` elements (and as many handles)
+static int reserve(struct PriorityQueue* pq, int needed) {
+    if (needed <= pq->capacity) {
+        return 0;
+    }
+    int newCapacity = pq->capacity;
+    while (newCapacity < needed) {
+        newCapacity *= 2;
     }
+    struct PQEntry* entries = (struct PQEntry*)realloc(pq->entries, newCapacity * sizeof(struct PQEntry));
+    if (entries == NULL) return -1;
+    pq->entries = entries;
+    int* position = (int*)realloc(pq->position, newCapacity * sizeof(int));
+    if (position == NULL) return -1;
+    pq->position = position;
+    int* freeHandles = (int*)realloc(pq->freeHandles, newCapacity * sizeof(int));
+    if (freeHandles == NULL) return -1;
+    pq->freeHandles = freeHandles;
+    uint32_t* generation = (uint32_t*)realloc(pq->generation, newCapacity * sizeof(uint32_t));
+    if (generation == NULL) return -1;
+    pq->generation = generation;
+    pq->capacity = newCapacity;
+    return 0;
+}
 
-    int i;
-    // Find the correct position based on priority
-    for (i = pq->count - 1; i >= 0 && pq->priorities[i] < priority; i--) {
-        pq->items[i + 1] = pq->items[i];
-        pq->priorities[i + 1] = pq->priorities[i];
+// Move the entry at index i up until its parent has a higher or equal priority
+static void siftUp(struct PriorityQueue* pq, int i) {
+    struct PQEntry entry = pq->entries[i];
+    while (i > 0) {
+        int parent = (i - 1) >> pq->arityShift;
+        if (pq->entries[parent].priority >= entry.priority) break;
+        pq->entries[i] = pq->entries[parent];
+        pq->position[pq->entries[i].handle] = i;
+        i = parent;
     }
-    // Insert the element in its position
-    pq->items[i + 1] = value;
-    pq->priorities[i + 1] = priority;
-    pq->count++;
-    printf("Inserted %d with priority %d\n", value, priority);
+    pq->entries[i] = entry;
+    pq->position[entry.handle] = i;
+}
+
+// Move the entry at index i down until all its children have a lower or equal priority
+static void siftDown(struct PriorityQueue* pq, int i) {
+    struct PQEntry entry = pq->entries[i];
+    int arity = 1 << pq->arityShift;
+    for (;;) {
+        int first = (i << pq->arityShift) + 1;
+        if (first >= pq->count) break;
+        int last = first + arity;
+        if (last > pq->count) last = pq->count;
+
+        // Pick the child with the highest priority
+        int best = first;
+        for (int c = first + 1; c < last; c++) {
+            if (pq->entries[c].priority > pq->entries[best].priority) best = c;
+        }
+        if (pq->entries[best].priority <= entry.priority) break;
+        pq->entries[i] = pq->entries[best];
+        pq->position[pq->entries[i].handle] = i;
+        i = best;
+    }
+    pq->entries[i] = entry;
+    pq->position[entry.handle] = i;
+}
+
+// Start a new generation for a handle slot; generation 0 is skipped so that
+// no handle is ever 0
+static void retireHandle(struct PriorityQueue* pq, int handle) {
+    if (++pq->generation[handle] == 0) pq->generation[handle] = 1;
+}
+
+static PQHandle makeHandle(struct PriorityQueue* pq, int handle) {
+    return (PQHandle)pq->generation[handle] << 32 | (uint32_t)handle;
+}
+
+// Enqueue operation with priority. Returns a handle for decreaseKey, or 0 on failure.
+PQHandle enqueue(struct PriorityQueue* pq, int value, int priority) {
+    if (reserve(pq, pq->count + 1) != 0) {
+        return 0;
+    }
+    int handle;
+    if (pq->freeCount > 0) {
+        handle = pq->freeHandles[--pq->freeCount];
+    } else {
+        handle = pq->nextHandle++;
+        pq->generation[handle] = 1;
+    }
+    int i = pq->count++;
+    pq->entries[i].item = value;
+    pq->entries[i].priority = priority;
+    pq->entries[i].handle = handle;
+    siftUp(pq, i);
+    return makeHandle(pq, handle);
 }
 
 // Dequeue operation (removes the highest priority element)
@@ -51,46 +178,232 @@ int dequeue(struct PriorityQueue* pq) {
         printf("Queue is empty!\n");
         return -1;
     }
-    // Remove the element with the highest priority (first element)
-    int value = pq->items[0];
-    // Shift all remaining elements
-    for (int i = 0; i < pq->count - 1; i++) {
-        pq->items[i] = pq->items[i + 1];
-        pq->priorities[i] = pq->priorities[i + 1];
-    }
+    int value = pq->entries[0].item;
+    retireHandle(pq, pq->entries[0].handle);
+    pq->freeHandles[pq->freeCount++] = pq->entries[0].handle;
     pq->count--;
-    printf("Deleted %d\n", value);
+    if (pq->count > 0) {
+        // Move the last element to the root and restore the heap
+        pq->entries[0] = pq->entries[pq->count];
+        siftDown(pq, 0);
+    }
     return value;
 }
 
-// Function to display the queue
+// Return the highest priority element without removing it
+int peek(struct PriorityQueue* pq) {
+    if (isEmpty(pq)) {
+        printf("Queue is empty!\n");
+        return -1;
+    }
+    return pq->entries[0].item;
+}
+
+// Change the priority of a queued element. Raising the priority moves it
+// towards the front, lowering it moves it back. Returns -1 for a stale handle.
+int decreaseKey(struct PriorityQueue* pq, PQHandle handle, int newPriority) {
+    uint32_t slot = (uint32_t)handle;
+    if (handle == 0 || slot >= (uint32_t)pq->nextHandle || pq->generation[slot] != (uint32_t)(handle >> 32)) {
+        return -1;
+    }
+    int i = pq->position[slot];
+    if (i < 0 || i >= pq->count || pq->entries[i].handle != (int)slot) {
+        return -1;
+    }
+    int oldPriority = pq->entries[i].priority;
+    pq->entries[i].priority = newPriority;
+    if (newPriority > oldPriority) {
+        siftUp(pq, i);
+    } else {
+        siftDown(pq, i);
+    }
+    return 0;
+}
+
+// Replace the contents of the queue with n elements in O(n). Handles given
+// out earlier become stale; if handles is not NULL, handles[i] receives the
+// handle of element i.
+int heapify(struct PriorityQueue* pq, const int* items, const int* priorities, int n, PQHandle* handles) {
+    if (reserve(pq, n) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < pq->nextHandle; i++) {
+        retireHandle(pq, i);
+    }
+    for (int i = 0; i < n; i++) {
+        pq->entries[i].item = items[i];
+        pq->entries[i].priority = priorities[i];
+        pq->entries[i].handle = i;
+        pq->position[i] = i;
+        if (i >= pq->nextHandle) pq->generation[i] = 1;
+        if (handles != NULL) handles[i] = makeHandle(pq, i);
+    }
+    pq->count = n;
+    // Slots past n stay retired on the free list, so their generations carry on
+    pq->freeCount = 0;
+    for (int i = pq->nextHandle - 1; i >= n; i--) {
+        pq->freeHandles[pq->freeCount++] = i;
+    }
+    if (n > pq->nextHandle) pq->nextHandle = n;
+    // Sift down every internal node, starting from the last one
+    for (int i = (n - 2) >> pq->arityShift; i >= 0 && n > 1; i--) {
+        siftDown(pq, i);
+    }
+    return 0;
+}
+
+// Function to display the queue (in heap order, not sorted order)
 void display(struct PriorityQueue* pq) {
     if (isEmpty(pq)) {
         printf("Queue is empty!\n");
     } else {
         printf("Queue elements with priorities: ");
         for (int i = 0; i < pq->count; i++) {
-            printf("%d(p%d) ", pq->items[i], pq->priorities[i]);
+            printf("%d(p%d) ", pq->entries[i].item, pq->entries[i].priority);
         }
         printf("\n");
     }
 }
 
-int main() {
+// ---------------------------------------------------------------------------
+// Benchmark: the heap against the previous sorted-array queue
+// ---------------------------------------------------------------------------
+
+// The previous implementation: keeps the array sorted by priority and shifts on every operation
+struct SortedArrayQueue {
+    int* items;
+    int* priorities;
+    int count;
+};
+
+static void sortedEnqueue(struct SortedArrayQueue* q, int value, int priority) {
+    int i;
+    for (i = q->count - 1; i >= 0 && q->priorities[i] < priority; i--) {
+        q->items[i + 1] = q->items[i];
+        q->priorities[i + 1] = q->priorities[i];
+    }
+    q->items[i + 1] = value;
+    q->priorities[i + 1] = priority;
+    q->count++;
+}
+
+static int sortedDequeue(struct SortedArrayQueue* q) {
+    int value = q->items[0];
+    for (int i = 0; i < q->count - 1; i++) {
+        q->items[i] = q->items[i + 1];
+        q->priorities[i] = q->priorities[i + 1];
+    }
+    q->count--;
+    return value;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// n enqueues with random priorities followed by n dequeues; returns ops/sec
+static double benchHeap(int n, int arity) {
     struct PriorityQueue pq;
-    initializeQueue(&pq);
+    unsigned int seed = 12345;
+    long long checksum = 0;
+    if (initializeQueue(&pq, arity) != 0) return 0;
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        enqueue(&pq, i, (int)(nextRandom(&seed) & 0x7fffffff));
+    }
+    for (int i = 0; i < n; i++) {
+        checksum += dequeue(&pq);
+    }
+    double elapsed = nowSeconds() - start;
+    destroyQueue(&pq);
+    if (checksum != (long long)n * (n - 1) / 2) printf("checksum mismatch\n");
+    return 2.0 * n / elapsed;
+}
+
+static double benchSortedArray(int n) {
+    struct SortedArrayQueue q;
+    unsigned int seed = 12345;
+    long long checksum = 0;
+    q.items = (int*)malloc(n * sizeof(int));
+    q.priorities = (int*)malloc(n * sizeof(int));
+    q.count = 0;
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        sortedEnqueue(&q, i, (int)(nextRandom(&seed) & 0x7fffffff));
+    }
+    for (int i = 0; i < n; i++) {
+        checksum += sortedDequeue(&q);
+    }
+    double elapsed = nowSeconds() - start;
+    free(q.items);
+    free(q.priorities);
+    if (checksum != (long long)n * (n - 1) / 2) printf("checksum mismatch\n");
+    return 2.0 * n / elapsed;
+}
+
+// The sorted array is O(n^2) overall, so it is only measured up to this size
+#define SORTED_ARRAY_LIMIT 100000
+
+static void runBenchmark(void) {
+    int sizes[] = {1000, 100000, 10000000};
+    printf("%-10s %16s %16s %16s %16s\n", "elements", "sorted array", "heap d=2", "heap d=4", "heap d=8");
+    for (int s = 0; s < 3; s++) {
+        int n = sizes[s];
+        printf("%-10d ", n);
+        if (n <= SORTED_ARRAY_LIMIT) {
+            printf("%16.0f ", benchSortedArray(n));
+        } else {
+            printf("%16s ", "(skipped)");
+        }
+        printf("%16.0f %16.0f %16.0f\n", benchHeap(n, 2), benchHeap(n, 4), benchHeap(n, 8));
+    }
+    printf("(ops/sec, one op = one enqueue or one dequeue)\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark();
+        return 0;
+    }
+
+    struct PriorityQueue pq;
+    initializeQueue(&pq, DEFAULT_ARITY);
 
     enqueue(&pq, 10, 2);
-    enqueue(&pq, 20, 1);
+    PQHandle handle = enqueue(&pq, 20, 1);
     enqueue(&pq, 30, 3);
     enqueue(&pq, 40, 0);
-    
+
     display(&pq);  // Display the queue
-    
-    dequeue(&pq);  // Remove the highest priority element
-    dequeue(&pq);  // Remove the next highest priority element
-    
+    printf("Front element: %d\n", peek(&pq));
+
+    decreaseKey(&pq, handle, 5);  // 20 becomes the most urgent element
+    printf("Front element after decreaseKey: %d\n", peek(&pq));
+
+    printf("Deleted %d\n", dequeue(&pq));  // Remove the highest priority element
+    printf("Deleted %d\n", dequeue(&pq));  // Remove the next highest priority element
+
     display(&pq);  // Display the queue after deletion
-    
+
+    // Build a queue from arrays in one go
+    int items[] = {1, 2, 3, 4, 5, 6};
+    int priorities[] = {4, 9, 1, 7, 3, 8};
+    heapify(&pq, items, priorities, 6, NULL);
+    printf("Dequeue order after heapify: ");
+    while (!isEmpty(&pq)) {
+        printf("%d ", dequeue(&pq));
+    }
+    printf("\n");
+
+    destroyQueue(&pq);
     return 0;
 }
@@ -1,63 +1,265 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-#define MAX_SIZE 100
+#define INITIAL_CAPACITY 16
 
+// Status codes returned by the stack functions (nothing is printed on the hot path)
+#define STACK_OK 0
+#define STACK_EMPTY -1      // Not enough elements for pop/peek
+#define STACK_NO_MEMORY -2  // The heap buffer could not be grown
+#define STACK_BAD_COUNT -3  // Negative count passed to push_n or pop_n
+
+// Heap-backed stack that doubles its buffer when it runs out of room
 typedef struct {
-    int data[MAX_SIZE];
-    int top;
+    int* data;
+    int top;        // Index of the top element, -1 when empty
+    int capacity;
 } Stack;
 
 void initialize(Stack *s) {
+    s->data = NULL;
     s->top = -1;
+    s->capacity = 0;
+}
+
+void destroy(Stack *s) {
+    free(s->data);
+    initialize(s);
 }
 
 int isEmpty(Stack *s) {
     return s->top == -1;
 }
 
-int isFull(Stack *s) {
-    return s->top == MAX_SIZE - 1;
+int size(Stack *s) {
+    return s->top + 1;
+}
+
+// Make sure the stack can hold at least `capacity` elements without reallocating
+int reserve(Stack *s, int capacity) {
+    if (capacity <= s->capacity) {
+        return STACK_OK;
+    }
+    int* data = (int*)realloc(s->data, (size_t)capacity * sizeof(int));
+    if (data == NULL) {
+        return STACK_NO_MEMORY;
+    }
+    s->data = data;
+    s->capacity = capacity;
+    return STACK_OK;
+}
+
+// Grow geometrically so that n pushes cost amortized O(1) each
+static int grow(Stack *s, int needed) {
+    int capacity = s->capacity > 0 ? s->capacity : INITIAL_CAPACITY;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    return reserve(s, capacity);
+}
+
+// Release unused capacity
+int shrink_to_fit(Stack *s) {
+    if (isEmpty(s)) {
+        destroy(s);
+        return STACK_OK;
+    }
+    int* data = (int*)realloc(s->data, (size_t)size(s) * sizeof(int));
+    if (data == NULL) {
+        return STACK_NO_MEMORY;
+    }
+    s->data = data;
+    s->capacity = size(s);
+    return STACK_OK;
+}
+
+int push(Stack *s, int value) {
+    if (s->top + 1 == s->capacity && grow(s, s->capacity + 1) != STACK_OK) {
+        return STACK_NO_MEMORY;
+    }
+    s->data[++s->top] = value;
+    return STACK_OK;
+}
+
+int pop(Stack *s, int *value) {
+    if (isEmpty(s)) {
+        return STACK_EMPTY;
+    }
+    *value = s->data[s->top--];
+    return STACK_OK;
+}
+
+int peek(Stack *s, int *value) {
+    if (isEmpty(s)) {
+        return STACK_EMPTY;
+    }
+    *value = s->data[s->top];
+    return STACK_OK;
+}
+
+// Push n values in one copy; values[n - 1] ends up on top
+int push_n(Stack *s, const int *values, int n) {
+    if (n < 0) {
+        return STACK_BAD_COUNT;
+    }
+    if (size(s) + n > s->capacity && grow(s, size(s) + n) != STACK_OK) {
+        return STACK_NO_MEMORY;
+    }
+    memcpy(s->data + s->top + 1, values, (size_t)n * sizeof(int));
+    s->top += n;
+    return STACK_OK;
+}
+
+// Pop the top n values in one copy. They are written to out in the order they
+// were pushed (the old top goes to out[n - 1]), so push_n(out) restores them.
+// Nothing is popped if the stack holds fewer than n values.
+int pop_n(Stack *s, int *out, int n) {
+    if (n < 0) {
+        return STACK_BAD_COUNT;
+    }
+    if (n > size(s)) {
+        return STACK_EMPTY;
+    }
+    s->top -= n;
+    memcpy(out, s->data + s->top + 1, (size_t)n * sizeof(int));
+    return STACK_OK;
 }
 
-void push(Stack *s, int value) {
-    if (isFull(s)) {
+// ---------------------------------------------------------------------------
+// Benchmark: push/pop throughput against the previous fixed-array stack
+// ---------------------------------------------------------------------------
+
+// The previous stack: a fixed array that prints on overflow/underflow. Its size
+// is raised here so it can hold the benchmark's depth.
+#define FIXED_SIZE 1000000
+
+typedef struct {
+    int data[FIXED_SIZE];
+    int top;
+} FixedStack;
+
+static void fixedPush(FixedStack *s, int value) {
+    if (s->top == FIXED_SIZE - 1) {
         printf("Stack Overflow\n");
         return;
     }
     s->data[++s->top] = value;
 }
 
-int pop(Stack *s) {
-    if (isEmpty(s)) {
+static int fixedPop(FixedStack *s) {
+    if (s->top == -1) {
         printf("Stack Underflow\n");
-        return -1; // Assuming -1 as an error code
+        return -1;
     }
     return s->data[s->top--];
 }
 
-int peek(Stack *s) {
-    if (isEmpty(s)) {
-        printf("Stack is Empty\n");
-        return -1; // Assuming -1 as an error code
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define BENCH_BATCH 64
+
+// Each round pushes `depth` values and pops them again
+static void runBenchmark(int depth, int rounds) {
+    static FixedStack fixed;
+    static int batch[BENCH_BATCH];
+    long long ops = 2LL * depth * rounds;
+    long long checksum[3] = {0, 0, 0};
+    double t0, elapsed[3];
+    int value = 0;
+    Stack s;
+
+    fixed.top = -1;
+    t0 = nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < depth; i++) fixedPush(&fixed, i);
+        for (int i = 0; i < depth; i++) checksum[0] += fixedPop(&fixed);
     }
-    return s->data[s->top];
+    elapsed[0] = nowSeconds() - t0;
+
+    // Growable stack, starting empty so the first round includes the growth
+    initialize(&s);
+    t0 = nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < depth; i++) push(&s, i);
+        for (int i = 0; i < depth; i++) {
+            pop(&s, &value);
+            checksum[1] += value;
+        }
+    }
+    elapsed[1] = nowSeconds() - t0;
+    destroy(&s);
+
+    // Growable stack with batches of BENCH_BATCH
+    initialize(&s);
+    t0 = nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < depth; i += BENCH_BATCH) {
+            for (int k = 0; k < BENCH_BATCH; k++) batch[k] = i + k;
+            push_n(&s, batch, BENCH_BATCH);
+        }
+        for (int i = 0; i < depth; i += BENCH_BATCH) {
+            pop_n(&s, batch, BENCH_BATCH);
+            for (int k = 0; k < BENCH_BATCH; k++) checksum[2] += batch[k];
+        }
+    }
+    elapsed[2] = nowSeconds() - t0;
+    destroy(&s);
+
+    if (checksum[0] != checksum[1] || checksum[0] != checksum[2]) printf("checksum mismatch\n");
+    printf("depth %d, %d rounds\n", depth, rounds);
+    printf("%-22s %16s\n", "stack", "ops/sec");
+    printf("%-22s %16.0f\n", "fixed array", ops / elapsed[0]);
+    printf("%-22s %16.0f\n", "growable push/pop", ops / elapsed[1]);
+    printf("%-22s %16.0f\n", "growable push_n/pop_n", ops / elapsed[2]);
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark(FIXED_SIZE - FIXED_SIZE % BENCH_BATCH, 100);
+        return 0;
+    }
+
     Stack s;
+    int value = 0;
     initialize(&s);
 
     push(&s, 10);
     push(&s, 20);
     push(&s, 30);
 
-    printf("Top element: %d\n", peek(&s));
+    peek(&s, &value);
+    printf("Top element: %d\n", value);
+
+    pop(&s, &value);
+    printf("Popped element: %d\n", value);
+    pop(&s, &value);
+    printf("Popped element: %d\n", value);
+
+    peek(&s, &value);
+    printf("Top element: %d\n", value);
+
+    // Bulk operations
+    int values[] = {40, 50, 60, 70};
+    push_n(&s, values, 4);
+    printf("Size after push_n: %d (capacity %d)\n", size(&s), s.capacity);
 
-    printf("Popped element: %d\n", pop(&s));
-    printf("Popped element: %d\n", pop(&s));
+    int out[2];
+    pop_n(&s, out, 2);
+    printf("pop_n returned: %d %d\n", out[0], out[1]);
 
-    printf("Top element: %d\n", peek(&s));
+    shrink_to_fit(&s);
+    printf("Capacity after shrink_to_fit: %d\n", s.capacity);
 
+    if (pop_n(&s, out, 5) == STACK_EMPTY) {
+        printf("Stack Underflow\n");
+    }
+
+    destroy(&s);
     return 0;
-}
\ No newline at end of file
+}
@@ -1,73 +1,223 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-#define MAX_SIZE 100
+#define INITIAL_CAPACITY 16  // Must be a power of two
 
+// Status codes returned by the queue functions
+#define QUEUE_OK 0
+#define QUEUE_EMPTY -1      // Not enough elements for dequeue/peek
+#define QUEUE_NO_MEMORY -2  // The buffer could not be grown
+
+// Growable ring buffer. front and rear are free-running counters: the number
+// of elements is rear - front and the slot of counter c is c & mask. Because
+// both wrap around the buffer, dequeued slots are reused and the queue never
+// drifts towards "full".
 typedef struct {
-    int data[MAX_SIZE];
-    int front, rear;
+    int* data;
+    unsigned int front;  // Counter of the next element to dequeue
+    unsigned int rear;   // Counter of the next free slot
+    unsigned int mask;   // capacity - 1, capacity is a power of two
 } Queue;
 
-void initialize(Queue *q) {
-    q->front = -1;
-    q->rear = -1;
+int initialize(Queue *q) {
+    q->data = (int*)malloc(INITIAL_CAPACITY * sizeof(int));
+    q->front = 0;
+    q->rear = 0;
+    q->mask = INITIAL_CAPACITY - 1;
+    return q->data != NULL ? QUEUE_OK : QUEUE_NO_MEMORY;
+}
+
+void destroy(Queue *q) {
+    free(q->data);
+    q->data = NULL;
+    q->front = q->rear = 0;
 }
 
 int isEmpty(Queue *q) {
-    return q->front == -1;
+    return q->front == q->rear;
+}
+
+unsigned int size(Queue *q) {
+    return q->rear - q->front;
 }
 
-int isFull(Queue *q) {
-    return q->rear == MAX_SIZE - 1;
+// Double the capacity until `needed` elements fit. The elements occupy at most
+// two contiguous pieces of the old buffer (before and after the wrap point);
+// both are copied to the start of the new buffer.
+static int grow(Queue *q, unsigned int needed) {
+    unsigned int capacity = q->mask + 1;
+    unsigned int newCapacity = capacity;
+    while (newCapacity < needed) {
+        newCapacity *= 2;
+    }
+    int* data = (int*)malloc((size_t)newCapacity * sizeof(int));
+    if (data == NULL) {
+        return QUEUE_NO_MEMORY;
+    }
+    unsigned int count = size(q);
+    unsigned int start = q->front & q->mask;
+    unsigned int first = capacity - start;
+    if (first > count) first = count;
+    memcpy(data, q->data + start, (size_t)first * sizeof(int));
+    memcpy(data + first, q->data, (size_t)(count - first) * sizeof(int));
+    free(q->data);
+    q->data = data;
+    q->front = 0;
+    q->rear = count;
+    q->mask = newCapacity - 1;
+    return QUEUE_OK;
 }
 
-void enqueue(Queue *q, int value) {
-    if (isFull(q)) {
-        printf("Queue Overflow\n");
-        return;
+int enqueue(Queue *q, int value) {
+    if (size(q) == q->mask + 1 && grow(q, size(q) + 1) != QUEUE_OK) {
+        return QUEUE_NO_MEMORY;
     }
+    q->data[q->rear++ & q->mask] = value;
+    return QUEUE_OK;
+}
+
+int dequeue(Queue *q, int *value) {
     if (isEmpty(q)) {
-        q->front = 0;
+        return QUEUE_EMPTY;
     }
-    q->data[++q->rear] = value;
+    *value = q->data[q->front++ & q->mask];
+    return QUEUE_OK;
 }
 
-int dequeue(Queue *q) {
+int peek(Queue *q, int *value) {
     if (isEmpty(q)) {
-        printf("Queue Underflow\n");
-        return -1; // Assuming -1 as an error code
+        return QUEUE_EMPTY;
     }
-    int value = q->data[q->front];
-    if (q->front == q->rear) {
-        q->front = q->rear = -1;
-    } else {
-        q->front++;
+    *value = q->data[q->front & q->mask];
+    return QUEUE_OK;
+}
+
+// Enqueue n values, copying at most two contiguous pieces
+int enqueue_n(Queue *q, const int *values, unsigned int n) {
+    if (size(q) + n > q->mask + 1 && grow(q, size(q) + n) != QUEUE_OK) {
+        return QUEUE_NO_MEMORY;
     }
-    return value;
+    unsigned int start = q->rear & q->mask;
+    unsigned int first = q->mask + 1 - start;
+    if (first > n) first = n;
+    memcpy(q->data + start, values, (size_t)first * sizeof(int));
+    memcpy(q->data, values + first, (size_t)(n - first) * sizeof(int));
+    q->rear += n;
+    return QUEUE_OK;
 }
 
-int peek(Queue *q) {
-    if (isEmpty(q)) {
-        printf("Queue is Empty\n");
-        return -1; // Assuming -1 as an error code
+// Dequeue n values into out in FIFO order. Nothing is removed if fewer than n are queued.
+int dequeue_n(Queue *q, int *out, unsigned int n) {
+    if (n > size(q)) {
+        return QUEUE_EMPTY;
+    }
+    unsigned int start = q->front & q->mask;
+    unsigned int first = q->mask + 1 - start;
+    if (first > n) first = n;
+    memcpy(out, q->data + start, (size_t)first * sizeof(int));
+    memcpy(out + first, q->data, (size_t)(n - first) * sizeof(int));
+    q->front += n;
+    return QUEUE_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Soak benchmark: a long run of operations at a steady working set
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define BENCH_BATCH 64
+
+// Keeps `workingSet` elements queued while performing `totalOps` operations
+// (half enqueues, half dequeues), checking FIFO order the whole way.
+static void runBenchmark(long long totalOps, unsigned int workingSet) {
+    Queue q;
+    int value = 0;
+    int batch[BENCH_BATCH];
+    long long rounds = totalOps / 2;
+    long long errors = 0;
+
+    initialize(&q);
+    for (unsigned int i = 0; i < workingSet; i++) enqueue(&q, (int)i);
+    int nextIn = (int)workingSet, nextOut = 0;
+    double t0 = nowSeconds();
+    for (long long i = 0; i < rounds; i++) {
+        enqueue(&q, nextIn++);
+        dequeue(&q, &value);
+        errors += (value != nextOut++);
+    }
+    double single = nowSeconds() - t0;
+    unsigned int capacity = q.mask + 1;
+    destroy(&q);
+
+    initialize(&q);
+    for (unsigned int i = 0; i < workingSet; i++) enqueue(&q, (int)i);
+    nextIn = (int)workingSet;
+    nextOut = 0;
+    t0 = nowSeconds();
+    for (long long i = 0; i < rounds; i += BENCH_BATCH) {
+        for (int k = 0; k < BENCH_BATCH; k++) batch[k] = nextIn++;
+        enqueue_n(&q, batch, BENCH_BATCH);
+        dequeue_n(&q, batch, BENCH_BATCH);
+        for (int k = 0; k < BENCH_BATCH; k++) errors += (batch[k] != nextOut++);
     }
-    return q->data[q->front];
+    double bulk = nowSeconds() - t0;
+    destroy(&q);
+
+    if (errors != 0) printf("FIFO order violated %lld times\n", errors);
+    printf("%lld ops at a working set of %u elements (capacity stayed at %u)\n",
+           totalOps, workingSet, capacity);
+    printf("%-24s %16s\n", "queue", "ops/sec");
+    printf("%-24s %16.0f\n", "enqueue/dequeue", totalOps / single);
+    printf("%-24s %16.0f\n", "enqueue_n/dequeue_n", totalOps / bulk);
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        long long ops = argc > 2 ? atoll(argv[2]) : 2000000000LL;
+        runBenchmark(ops, 1000);
+        return 0;
+    }
+
     Queue q;
+    int value = 0;
     initialize(&q);
 
     enqueue(&q, 10);
     enqueue(&q, 20);
     enqueue(&q, 30);
 
-    printf("Front element: %d\n", peek(&q));
+    peek(&q, &value);
+    printf("Front element: %d\n", value);
 
-    printf("Dequeued element: %d\n", dequeue(&q));
-    printf("Dequeued element: %d\n", dequeue(&q));
+    dequeue(&q, &value);
+    printf("Dequeued element: %d\n", value);
+    dequeue(&q, &value);
+    printf("Dequeued element: %d\n", value);
 
-    printf("Front element: %d\n", peek(&q));
+    peek(&q, &value);
+    printf("Front element: %d\n", value);
 
+    // Many more operations than the old MAX_SIZE of 100; slots are reused
+    for (int i = 0; i < 1000; i++) {
+        enqueue(&q, i);
+        dequeue(&q, &value);
+    }
+    printf("After 1000 enqueue/dequeue pairs: size %u, capacity %u\n", size(&q), q.mask + 1);
+
+    // Growing past the initial capacity keeps FIFO order
+    int values[40];
+    for (int i = 0; i < 40; i++) values[i] = 100 + i;
+    enqueue_n(&q, values, 40);
+    dequeue_n(&q, values, 3);
+    printf("dequeue_n returned: %d %d %d (capacity %u)\n", values[0], values[1], values[2], q.mask + 1);
+
+    destroy(&q);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,458 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// Hierarchical timing wheel for timeouts.
+//
+// Level 0 is a circular array of WHEEL_SLOTS slots, one tick each; level L
+// has the same number of slots, each covering WHEEL_SLOTS^L ticks. A timer
+// goes into the lowest level whose range covers its delay, on a doubly
+// linked slot list, so adding and cancelling are O(1). When level 0 wraps
+// around, the current slot of level 1 is emptied and its timers are placed
+// again (into level 0 now that they are close); level 2 cascades into level 1
+// the same way, and so on. A timer is re-placed at most once per level, so
+// cascading costs O(levels) per timer over its life.
+//
+// Each level keeps a bitmap of non-empty slots, so advancing the clock jumps
+// straight to the next tick that has work instead of visiting idle ones. The
+// timers that expire on a tick are handed to the callback as one batch.
+//
+// Timers live in one growable array and are linked by index. A handle carries
+// the timer's generation, so cancelling a timer that has already fired or
+// been cancelled is detected instead of hitting a reused slot.
+
+#define WHEEL_BITS 8
+#define WHEEL_SLOTS (1 << WHEEL_BITS)   // Slots per level
+#define WHEEL_LEVELS 4                  // Delays up to 2^32 ticks are placed directly
+#define WHEEL_NONE -1
+#define INITIAL_TIMERS 64
+
+typedef uint64_t TimerHandle;  // 0 is never a valid handle
+
+// Called once per tick with the data of every timer that expired on it
+typedef void (*ExpiryFn)(const int* data, int count, uint64_t tick, void* context);
+
+struct Timer {
+    uint64_t expires;
+    int prev;
+    int next;         // Also links the free list
+    int list;         // Slot list the timer is on, or WHEEL_NONE when free
+    int data;
+    uint32_t generation;
+};
+
+struct TimingWheel {
+    struct Timer* timers;
+    int capacity;
+    int used;                    // Timers ever handed out
+    int freeHead;
+    int heads[WHEEL_LEVELS * WHEEL_SLOTS];
+    uint64_t occupied[WHEEL_LEVELS][WHEEL_SLOTS / 64];
+    uint64_t now;                // Last tick processed
+    size_t pending;
+    int* batch;                  // Data of the timers expiring this tick
+    int batchCapacity;
+};
+
+// Initialize an empty wheel whose clock reads startTick. Returns 0, or -1 if
+// out of memory.
+int wheelInit(struct TimingWheel* w, uint64_t startTick) {
+    w->timers = (struct Timer*)malloc(INITIAL_TIMERS * sizeof(struct Timer));
+    w->batch = (int*)malloc(INITIAL_TIMERS * sizeof(int));
+    if (w->timers == NULL || w->batch == NULL) {
+        free(w->timers);
+        free(w->batch);
+        return -1;
+    }
+    w->capacity = INITIAL_TIMERS;
+    w->batchCapacity = INITIAL_TIMERS;
+    w->used = 0;
+    w->freeHead = WHEEL_NONE;
+    for (int i = 0; i < WHEEL_LEVELS * WHEEL_SLOTS; i++) w->heads[i] = WHEEL_NONE;
+    memset(w->occupied, 0, sizeof(w->occupied));
+    w->now = startTick;
+    w->pending = 0;
+    return 0;
+}
+
+void wheelDestroy(struct TimingWheel* w) {
+    free(w->timers);
+    free(w->batch);
+    w->timers = NULL;
+    w->batch = NULL;
+}
+
+size_t wheelPending(struct TimingWheel* w) {
+    return w->pending;
+}
+
+static inline void pushTimer(struct TimingWheel* w, int list, int index) {
+    struct Timer* t = &w->timers[index];
+    t->list = list;
+    t->prev = WHEEL_NONE;
+    t->next = w->heads[list];
+    if (t->next != WHEEL_NONE) w->timers[t->next].prev = index;
+    w->heads[list] = index;
+    w->occupied[list / WHEEL_SLOTS][(list % WHEEL_SLOTS) / 64] |= (uint64_t)1 << (list % 64);
+}
+
+static inline void unlinkTimer(struct TimingWheel* w, int index) {
+    struct Timer* t = &w->timers[index];
+    if (t->prev != WHEEL_NONE) {
+        w->timers[t->prev].next = t->next;
+    } else {
+        w->heads[t->list] = t->next;
+        if (t->next == WHEEL_NONE) {
+            w->occupied[t->list / WHEEL_SLOTS][(t->list % WHEEL_SLOTS) / 64] &= ~((uint64_t)1 << (t->list % 64));
+        }
+    }
+    if (t->next != WHEEL_NONE) w->timers[t->next].prev = t->prev;
+}
+
+// Take a whole slot list off the wheel; returns its first timer
+static inline int detachList(struct TimingWheel* w, int list) {
+    int first = w->heads[list];
+    w->heads[list] = WHEEL_NONE;
+    w->occupied[list / WHEEL_SLOTS][(list % WHEEL_SLOTS) / 64] &= ~((uint64_t)1 << (list % 64));
+    return first;
+}
+
+// Put a timer on the slot for its expiry, relative to the current tick
+static void placeTimer(struct TimingWheel* w, int index) {
+    uint64_t expires = w->timers[index].expires;
+    uint64_t diff = expires - w->now;   // 0 only while cascading into the current tick
+    int level = diff < WHEEL_SLOTS ? 0 : (63 - __builtin_clzll(diff)) / WHEEL_BITS;
+    if (level >= WHEEL_LEVELS) {
+        // Past the top level: park in its furthest slot and place again when it cascades
+        level = WHEEL_LEVELS - 1;
+        expires = w->now + ((uint64_t)1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+    }
+    int slot = (int)(expires >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+    pushTimer(w, level * WHEEL_SLOTS + slot, index);
+}
+
+// Schedule `data` to expire `delay` ticks from now (a delay of 0 counts as 1).
+// Returns a handle for wheelCancel, or 0 if out of memory.
+TimerHandle wheelAdd(struct TimingWheel* w, uint64_t delay, int data) {
+    int index;
+    if (w->freeHead != WHEEL_NONE) {
+        index = w->freeHead;
+        w->freeHead = w->timers[index].next;
+    } else {
+        if (w->used == w->capacity) {
+            struct Timer* grown = (struct Timer*)realloc(w->timers, 2 * (size_t)w->capacity * sizeof(struct Timer));
+            if (grown == NULL) return 0;
+            w->timers = grown;
+            w->capacity *= 2;
+        }
+        index = w->used++;
+        w->timers[index].generation = 1;
+    }
+    struct Timer* t = &w->timers[index];
+    t->expires = w->now + (delay > 0 ? delay : 1);
+    t->data = data;
+    placeTimer(w, index);
+    w->pending++;
+    return (TimerHandle)t->generation << 32 | (uint32_t)index;
+}
+
+static inline void releaseTimer(struct TimingWheel* w, int index) {
+    struct Timer* t = &w->timers[index];
+    t->list = WHEEL_NONE;
+    t->generation++;
+    t->next = w->freeHead;
+    w->freeHead = index;
+    w->pending--;
+}
+
+// Cancel a pending timer. Returns 0, or -1 if the handle is stale (the timer
+// already fired or was cancelled).
+int wheelCancel(struct TimingWheel* w, TimerHandle handle) {
+    uint32_t index = (uint32_t)handle;   // Unsigned, so no handle maps to a negative index
+    if (handle == 0 || index >= (uint32_t)w->used) return -1;
+    struct Timer* t = &w->timers[index];
+    if (t->list == WHEEL_NONE || t->generation != (uint32_t)(handle >> 32)) return -1;
+    unlinkTimer(w, (int)index);
+    releaseTimer(w, (int)index);
+    return 0;
+}
+
+// Ticks from now to the next one that expires or cascades a non-empty slot.
+// The lowest non-empty level decides: its next occupied slot in the current
+// rotation, or else its wrap-around (after which its remaining slots come
+// round again).
+static uint64_t ticksToNextWork(struct TimingWheel* w) {
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        const uint64_t* bitmap = w->occupied[level];
+        if ((bitmap[0] | bitmap[1] | bitmap[2] | bitmap[3]) == 0) continue;
+        int shift = WHEEL_BITS * level;
+        int base = (int)(w->now >> shift) & (WHEEL_SLOTS - 1);
+        int slot = WHEEL_SLOTS;   // Wrap-around if nothing is found
+        for (int word = (base + 1) / 64; word < WHEEL_SLOTS / 64; word++) {
+            uint64_t bits = bitmap[word];
+            if (word == (base + 1) / 64) bits &= ~(uint64_t)0 << ((base + 1) % 64);
+            if (bits != 0) {
+                slot = word * 64 + __builtin_ctzll(bits);
+                break;
+            }
+        }
+        return (((w->now >> shift) + (uint64_t)(slot - base)) << shift) - w->now;
+    }
+    return UINT64_MAX;  // Empty wheel
+}
+
+// Level 0 has wrapped: bring down the current slot of level 1, and of each
+// higher level whose index has wrapped as well
+static void cascade(struct TimingWheel* w) {
+    for (int level = 1; level < WHEEL_LEVELS; level++) {
+        int slot = (int)(w->now >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+        int index = detachList(w, level * WHEEL_SLOTS + slot);
+        while (index != WHEEL_NONE) {
+            int next = w->timers[index].next;
+            placeTimer(w, index);
+            index = next;
+        }
+        if (slot != 0) break;
+    }
+}
+
+// Fire the current level-0 slot as one batch. The timers are released first,
+// so the callback may add new ones.
+static uint64_t expireSlot(struct TimingWheel* w, ExpiryFn fn, void* context) {
+    int index = detachList(w, (int)(w->now & (WHEEL_SLOTS - 1)));
+    int count = 0;
+    uint64_t fired = 0;
+    while (index != WHEEL_NONE) {
+        if (count == w->batchCapacity) {
+            int* grown = (int*)realloc(w->batch, 2 * (size_t)w->batchCapacity * sizeof(int));
+            if (grown != NULL) {
+                w->batch = grown;
+                w->batchCapacity *= 2;
+            } else {
+                // Out of memory: hand over what we have and keep going
+                if (fn != NULL) fn(w->batch, count, w->now, context);
+                fired += count;
+                count = 0;
+            }
+        }
+        int next = w->timers[index].next;
+        w->batch[count++] = w->timers[index].data;
+        releaseTimer(w, index);
+        index = next;
+    }
+    if (count > 0 && fn != NULL) fn(w->batch, count, w->now, context);
+    return fired + count;
+}
+
+// Move the clock forward by `ticks`, firing every timer that comes due.
+// Returns the number of timers fired.
+uint64_t wheelAdvance(struct TimingWheel* w, uint64_t ticks, ExpiryFn fn, void* context) {
+    uint64_t target = w->now + ticks;
+    uint64_t fired = 0;
+    while (w->now < target) {
+        uint64_t step = ticksToNextWork(w);
+        if (step > target - w->now) {
+            w->now = target;  // Nothing to do before the target
+            break;
+        }
+        w->now += step;
+        if ((w->now & (WHEEL_SLOTS - 1)) == 0) cascade(w);
+        fired += expireSlot(w, fn, context);
+    }
+    return fired;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: the wheel against a sorted-array timer queue (the approach of
+// PriorityQueue.c's sorted array), with 1M pending timers
+// ---------------------------------------------------------------------------
+
+// Deadlines sorted latest first, so the next timer to fire is at the end.
+// Insert and cancel shift the array: O(n).
+struct SortedTimers {
+    uint64_t* expires;
+    int* ids;
+    uint64_t* deadlineOf;   // deadlineOf[id], to find a timer when cancelling
+    int count;
+};
+
+// Index of the first entry that sorts after (expires, id) in latest-first order
+static int sortedPosition(struct SortedTimers* q, uint64_t expires, int id) {
+    int lo = 0, hi = q->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (q->expires[mid] > expires || (q->expires[mid] == expires && q->ids[mid] > id)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void sortedAdd(struct SortedTimers* q, uint64_t expires, int id) {
+    int i = sortedPosition(q, expires, id);
+    memmove(q->expires + i + 1, q->expires + i, (size_t)(q->count - i) * sizeof(uint64_t));
+    memmove(q->ids + i + 1, q->ids + i, (size_t)(q->count - i) * sizeof(int));
+    q->expires[i] = expires;
+    q->ids[i] = id;
+    q->deadlineOf[id] = expires;
+    q->count++;
+}
+
+static void sortedCancel(struct SortedTimers* q, int id) {
+    int i = sortedPosition(q, q->deadlineOf[id], id);
+    memmove(q->expires + i, q->expires + i + 1, (size_t)(q->count - i - 1) * sizeof(uint64_t));
+    memmove(q->ids + i, q->ids + i + 1, (size_t)(q->count - i - 1) * sizeof(int));
+    q->count--;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void countFired(const int* data, int count, uint64_t tick, void* context) {
+    uint64_t* sum = (uint64_t*)context;
+    (void)tick;
+    for (int i = 0; i < count; i++) sum[0] += (uint64_t)data[i];
+    sum[1]++;   // Batches
+}
+
+static int compareLatestFirst(const void* a, const void* b) {
+    const uint64_t* x = (const uint64_t*)a;
+    const uint64_t* y = (const uint64_t*)b;
+    if (x[0] != y[0]) return x[0] < y[0] ? 1 : -1;
+    return x[1] < y[1] ? 1 : (x[1] > y[1] ? -1 : 0);
+}
+
+#define SORTED_CHURN_OPS 2000  // Shifting 1M entries per op: keep the count small
+
+// n timers with delays up to `horizon` ticks; then `churn` cancel+add pairs
+// (timeouts that are mostly cancelled before firing); then run the clock
+// until every timer has fired.
+static void runBenchmark(int n, uint64_t horizon, int churn) {
+    uint64_t seed = 2024;
+    uint64_t* delays = (uint64_t*)malloc((size_t)(n + churn) * sizeof(uint64_t));
+    int* victims = (int*)malloc((size_t)churn * sizeof(int));
+    for (int i = 0; i < n + churn; i++) delays[i] = 1 + nextRandom(&seed) % horizon;
+    for (int i = 0; i < churn; i++) victims[i] = (int)(nextRandom(&seed) % (uint64_t)n);
+
+    // Timing wheel
+    struct TimingWheel w;
+    TimerHandle* handles = (TimerHandle*)malloc((size_t)n * sizeof(TimerHandle));
+    wheelInit(&w, 0);
+    double t0 = nowSeconds();
+    for (int i = 0; i < n; i++) handles[i] = wheelAdd(&w, delays[i], i);
+    double wheelLoad = (nowSeconds() - t0) / n;
+    t0 = nowSeconds();
+    for (int i = 0; i < churn; i++) {
+        int v = victims[i];
+        wheelCancel(&w, handles[v]);
+        handles[v] = wheelAdd(&w, delays[n + i], v);
+    }
+    double wheelChurn = (nowSeconds() - t0) / churn;
+    uint64_t sums[2] = {0, 0};
+    t0 = nowSeconds();
+    uint64_t fired = wheelAdvance(&w, horizon + 1, countFired, sums);
+    double wheelDrain = (nowSeconds() - t0) / n;
+    if (fired != (uint64_t)n || wheelPending(&w) != 0 || sums[0] != (uint64_t)n * (n - 1) / 2) {
+        printf("wheel lost timers\n");
+    }
+    wheelDestroy(&w);
+    free(handles);
+
+    // Sorted array, loaded with one sort: n sorted inserts would be O(n^2)
+    struct SortedTimers q;
+    q.expires = (uint64_t*)malloc((size_t)(n + 1) * sizeof(uint64_t));
+    q.ids = (int*)malloc((size_t)(n + 1) * sizeof(int));
+    q.deadlineOf = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+    uint64_t* pairs = (uint64_t*)malloc((size_t)n * 2 * sizeof(uint64_t));
+    for (int i = 0; i < n; i++) {
+        pairs[2 * i] = delays[i];
+        pairs[2 * i + 1] = (uint64_t)i;
+        q.deadlineOf[i] = delays[i];
+    }
+    qsort(pairs, (size_t)n, 2 * sizeof(uint64_t), compareLatestFirst);
+    for (int i = 0; i < n; i++) {
+        q.expires[i] = pairs[2 * i];
+        q.ids[i] = (int)pairs[2 * i + 1];
+    }
+    q.count = n;
+    free(pairs);
+    int sortedOps = churn < SORTED_CHURN_OPS ? churn : SORTED_CHURN_OPS;
+    t0 = nowSeconds();
+    for (int i = 0; i < sortedOps; i++) {
+        sortedCancel(&q, victims[i]);
+        sortedAdd(&q, delays[n + i], victims[i]);
+    }
+    double sortedChurn = (nowSeconds() - t0) / sortedOps;
+    uint64_t sortedFired = 0, sortedSum = 0;
+    t0 = nowSeconds();
+    for (uint64_t tick = 1; tick <= horizon; tick++) {
+        while (q.count > 0 && q.expires[q.count - 1] <= tick) {
+            sortedSum += (uint64_t)q.ids[--q.count];
+            sortedFired++;
+        }
+    }
+    double sortedDrain = (nowSeconds() - t0) / n;
+    if (sortedFired != (uint64_t)n || sortedSum != (uint64_t)n * (n - 1) / 2) printf("sorted array lost timers\n");
+    free(q.expires);
+    free(q.ids);
+    free(q.deadlineOf);
+    free(delays);
+    free(victims);
+
+    printf("%d timers, delays 1..%llu ticks (ns per timer)\n", n, (unsigned long long)horizon);
+    printf("%-14s %14s %22s %14s\n", "queue", "add (load)", "cancel + add (churn)", "expire");
+    printf("%-14s %14.1f %22.1f %14.1f\n", "timing wheel", wheelLoad * 1e9, wheelChurn * 1e9, wheelDrain * 1e9);
+    printf("%-14s %14s %22.1f %14.1f\n", "sorted array", "(sorted once)", sortedChurn * 1e9, sortedDrain * 1e9);
+    printf("%llu expiry batches on the wheel, %d churn ops on the wheel, %d on the sorted array\n",
+           (unsigned long long)sums[1], churn, sortedOps);
+}
+
+static void printExpired(const int* data, int count, uint64_t tick, void* context) {
+    (void)context;
+    printf("tick %llu:", (unsigned long long)tick);
+    for (int i = 0; i < count; i++) printf(" %d", data[i]);
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [timers] [horizon ticks] [churn ops]
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        uint64_t horizon = argc > 3 ? strtoull(argv[3], NULL, 10) : 1000000;
+        int churn = argc > 4 ? atoi(argv[4]) : 1000000;
+        if (n < 1 || horizon < 1 || churn < 0) return 1;
+        runBenchmark(n, horizon, churn);
+        return 0;
+    }
+
+    struct TimingWheel w;
+    wheelInit(&w, 0);
+    wheelAdd(&w, 5, 1);
+    wheelAdd(&w, 5, 2);
+    TimerHandle cancelled = wheelAdd(&w, 300, 3);
+    wheelAdd(&w, 300, 4);
+    wheelAdd(&w, 70000, 5);
+    wheelCancel(&w, cancelled);
+    printf("Pending: %zu\n", wheelPending(&w));   // 4
+
+    wheelAdvance(&w, 100000, printExpired, NULL);  // 2 1 at tick 5, 4 at 300, 5 at 70000
+    if (wheelCancel(&w, cancelled) != 0) {
+        printf("Handle of timer 3 is stale\n");
+    }
+    wheelDestroy(&w);
+    return 0;
+}
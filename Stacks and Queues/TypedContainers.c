@@ -0,0 +1,413 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "TypedContainers.h"
+
+// Demo and benchmark for the macro templates in TypedContainers.h.
+//
+// The benchmark stores 8-, 16- and 64-byte payloads in the inline stack,
+// ring and priority queue, and in the same containers written the
+// type-erased way: an array of void*, one malloc'd box per element, and a
+// comparison function called through a pointer.
+
+// ---------------------------------------------------------------------------
+// Demo types
+// ---------------------------------------------------------------------------
+
+struct Point {
+    int x;
+    int y;
+};
+
+struct Job {
+    int priority;  // Lower runs first
+    const char* name;
+};
+
+#define JOB_LESS(a, b) ((a)->priority < (b)->priority)
+
+DEFINE_STACK(uint64_t, IdStack)
+DEFINE_RING(struct Point, PointRing)
+DEFINE_PQUEUE(struct Job, JobQueue, JOB_LESS)
+
+// ---------------------------------------------------------------------------
+// void* baselines: every element is boxed in its own allocation
+// ---------------------------------------------------------------------------
+
+struct BoxedStack {
+    void** items;
+    size_t count;
+    size_t capacity;
+};
+
+static int boxedStackPush(struct BoxedStack* s, const void* value, size_t size) {
+    if (s->count == s->capacity) {
+        size_t capacity = tc_grow_capacity(s->capacity, s->count + 1);
+        void** items = (void**)realloc(s->items, capacity * sizeof(void*));
+        if (items == NULL) return -1;
+        s->items = items;
+        s->capacity = capacity;
+    }
+    void* box = malloc(size);
+    if (box == NULL) return -1;
+    memcpy(box, value, size);
+    s->items[s->count++] = box;
+    return 0;
+}
+
+static int boxedStackPop(struct BoxedStack* s, void* out, size_t size) {
+    if (s->count == 0) return -1;
+    void* box = s->items[--s->count];
+    memcpy(out, box, size);
+    free(box);
+    return 0;
+}
+
+struct BoxedRing {
+    void** items;
+    size_t head;
+    size_t count;
+    size_t capacity;  // Power of two
+};
+
+static int boxedRingPush(struct BoxedRing* r, const void* value, size_t size) {
+    if (r->count == r->capacity) {
+        size_t capacity = tc_grow_capacity(r->capacity, r->count + 1);
+        void** items = (void**)malloc(capacity * sizeof(void*));
+        if (items == NULL) return -1;
+        for (size_t i = 0; i < r->count; i++) items[i] = r->items[(r->head + i) & (r->capacity - 1)];
+        free(r->items);
+        r->items = items;
+        r->head = 0;
+        r->capacity = capacity;
+    }
+    void* box = malloc(size);
+    if (box == NULL) return -1;
+    memcpy(box, value, size);
+    r->items[(r->head + r->count++) & (r->capacity - 1)] = box;
+    return 0;
+}
+
+static int boxedRingPop(struct BoxedRing* r, void* out, size_t size) {
+    if (r->count == 0) return -1;
+    void* box = r->items[r->head];
+    r->head = (r->head + 1) & (r->capacity - 1);
+    r->count--;
+    memcpy(out, box, size);
+    free(box);
+    return 0;
+}
+
+// The same 4-ary heap and hole sifting as DEFINE_PQUEUE, on boxes
+struct BoxedPQueue {
+    void** items;
+    size_t count;
+    size_t capacity;
+    int (*less)(const void* a, const void* b);
+};
+
+static int boxedPQueuePush(struct BoxedPQueue* q, const void* value, size_t size) {
+    if (q->count == q->capacity) {
+        size_t capacity = tc_grow_capacity(q->capacity, q->count + 1);
+        void** items = (void**)realloc(q->items, capacity * sizeof(void*));
+        if (items == NULL) return -1;
+        q->items = items;
+        q->capacity = capacity;
+    }
+    void* box = malloc(size);
+    if (box == NULL) return -1;
+    memcpy(box, value, size);
+    size_t i = q->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) >> TC_PQ_ARITY_SHIFT;
+        if (!q->less(box, q->items[parent])) break;
+        q->items[i] = q->items[parent];
+        i = parent;
+    }
+    q->items[i] = box;
+    return 0;
+}
+
+static int boxedPQueuePop(struct BoxedPQueue* q, void* out, size_t size) {
+    if (q->count == 0) return -1;
+    void* top = q->items[0];
+    void* last = q->items[--q->count];
+    size_t i = 0;
+    for (;;) {
+        size_t first = (i << TC_PQ_ARITY_SHIFT) + 1;
+        if (first >= q->count) break;
+        size_t end = first + ((size_t)1 << TC_PQ_ARITY_SHIFT);
+        if (end > q->count) end = q->count;
+        size_t best = first;
+        for (size_t c = first + 1; c < end; c++) {
+            if (q->less(q->items[c], q->items[best])) best = c;
+        }
+        if (!q->less(q->items[best], last)) break;
+        q->items[i] = q->items[best];
+        i = best;
+    }
+    if (q->count > 0) q->items[i] = last;
+    memcpy(out, top, size);
+    free(top);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: push n elements and take them out again. Each payload starts
+// with its 64-bit key; the remaining bytes are copied along with it.
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+struct Payload8 {
+    uint64_t key;
+};
+
+struct Payload16 {
+    uint64_t key;
+    uint64_t value;
+};
+
+struct Payload64 {
+    uint64_t key;
+    uint64_t fields[7];
+};
+
+#define KEY_LESS(a, b) ((a)->key < (b)->key)
+
+// Every payload starts with its key, so one comparator serves all three
+static int boxedKeyLess(const void* a, const void* b) {
+    return *(const uint64_t*)a < *(const uint64_t*)b;
+}
+
+#define RING_DEPTH 1024  // Elements kept queued while the ring benchmark runs
+#define BULK 64          // Elements per push_n / pop_n
+
+// Each run returns a checksum over the keys it took out (in order, for the
+// priority queue), so inline and boxed runs can be compared
+#define DEFINE_PAYLOAD_BENCH(T, tag)                                                                \
+    DEFINE_STACK(T, tag##Stack)                                                                     \
+    DEFINE_RING(T, tag##Ring)                                                                       \
+    DEFINE_PQUEUE(T, tag##Queue, KEY_LESS)                                                          \
+                                                                                                    \
+    static T tag##Make(uint64_t key) {                                                              \
+        T p;                                                                                        \
+        memset(&p, 0, sizeof(p));                                                                   \
+        p.key = key;                                                                                \
+        return p;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##StackInline(const uint64_t* keys, int n) {                                 \
+        struct tag##Stack s;                                                                        \
+        tag##Stack_init(&s);                                                                        \
+        uint64_t sum = 0;                                                                           \
+        T p;                                                                                        \
+        for (int i = 0; i < n; i++) tag##Stack_push(&s, tag##Make(keys[i]));                        \
+        while (tag##Stack_pop(&s, &p) == 0) sum = sum * 31 + p.key;                                 \
+        tag##Stack_destroy(&s);                                                                     \
+        return sum;                                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##StackBoxed(const uint64_t* keys, int n) {                                  \
+        struct BoxedStack s = {NULL, 0, 0};                                                         \
+        uint64_t sum = 0;                                                                           \
+        T p;                                                                                        \
+        for (int i = 0; i < n; i++) {                                                               \
+            p = tag##Make(keys[i]);                                                                 \
+            boxedStackPush(&s, &p, sizeof(T));                                                      \
+        }                                                                                           \
+        while (boxedStackPop(&s, &p, sizeof(T)) == 0) sum = sum * 31 + p.key;                       \
+        free(s.items);                                                                              \
+        return sum;                                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##RingInline(const uint64_t* keys, int n) {                                  \
+        struct tag##Ring r;                                                                         \
+        tag##Ring_init(&r);                                                                         \
+        uint64_t sum = 0;                                                                           \
+        T p;                                                                                        \
+        for (int i = 0; i < n; i++) {                                                               \
+            tag##Ring_push(&r, tag##Make(keys[i]));                                                 \
+            if (r.count > RING_DEPTH && tag##Ring_pop(&r, &p) == 0) sum = sum * 31 + p.key;         \
+        }                                                                                           \
+        while (tag##Ring_pop(&r, &p) == 0) sum = sum * 31 + p.key;                                  \
+        tag##Ring_destroy(&r);                                                                      \
+        return sum;                                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##RingBulk(const uint64_t* keys, int n) {                                    \
+        struct tag##Ring r;                                                                         \
+        tag##Ring_init(&r);                                                                         \
+        uint64_t sum = 0;                                                                           \
+        T batch[BULK];                                                                              \
+        for (int i = 0; i < n; i += BULK) {                                                         \
+            int m = n - i < BULK ? n - i : BULK;                                                    \
+            for (int j = 0; j < m; j++) batch[j] = tag##Make(keys[i + j]);                          \
+            tag##Ring_push_n(&r, batch, (size_t)m);                                                 \
+            if (r.count > RING_DEPTH) {                                                             \
+                size_t got = tag##Ring_pop_n(&r, batch, r.count - RING_DEPTH);                      \
+                for (size_t j = 0; j < got; j++) sum = sum * 31 + batch[j].key;                     \
+            }                                                                                       \
+        }                                                                                           \
+        size_t got;                                                                                 \
+        while ((got = tag##Ring_pop_n(&r, batch, BULK)) > 0) {                                      \
+            for (size_t j = 0; j < got; j++) sum = sum * 31 + batch[j].key;                         \
+        }                                                                                           \
+        tag##Ring_destroy(&r);                                                                      \
+        return sum;                                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##RingBoxed(const uint64_t* keys, int n) {                                   \
+        struct BoxedRing r = {NULL, 0, 0, 0};                                                       \
+        uint64_t sum = 0;                                                                           \
+        T p;                                                                                        \
+        for (int i = 0; i < n; i++) {                                                               \
+            p = tag##Make(keys[i]);                                                                 \
+            boxedRingPush(&r, &p, sizeof(T));                                                       \
+            if (r.count > RING_DEPTH && boxedRingPop(&r, &p, sizeof(T)) == 0) sum = sum * 31 + p.key; \
+        }                                                                                           \
+        while (boxedRingPop(&r, &p, sizeof(T)) == 0) sum = sum * 31 + p.key;                        \
+        free(r.items);                                                                              \
+        return sum;                                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##QueueInline(const uint64_t* keys, int n) {                                 \
+        struct tag##Queue q;                                                                        \
+        tag##Queue_init(&q);                                                                        \
+        uint64_t sum = 0;                                                                           \
+        T p;                                                                                        \
+        for (int i = 0; i < n; i++) tag##Queue_push(&q, tag##Make(keys[i]));                        \
+        while (tag##Queue_pop(&q, &p) == 0) sum = sum * 31 + p.key;                                 \
+        tag##Queue_destroy(&q);                                                                     \
+        return sum;                                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    static uint64_t tag##QueueBoxed(const uint64_t* keys, int n) {                                  \
+        struct BoxedPQueue q = {NULL, 0, 0, boxedKeyLess};                                          \
+        uint64_t sum = 0;                                                                           \
+        T p;                                                                                        \
+        for (int i = 0; i < n; i++) {                                                               \
+            p = tag##Make(keys[i]);                                                                 \
+            boxedPQueuePush(&q, &p, sizeof(T));                                                     \
+        }                                                                                           \
+        while (boxedPQueuePop(&q, &p, sizeof(T)) == 0) sum = sum * 31 + p.key;                      \
+        free(q.items);                                                                              \
+        return sum;                                                                                 \
+    }
+
+DEFINE_PAYLOAD_BENCH(struct Payload8, P8)
+DEFINE_PAYLOAD_BENCH(struct Payload16, P16)
+DEFINE_PAYLOAD_BENCH(struct Payload64, P64)
+
+typedef uint64_t (*BenchFn)(const uint64_t* keys, int n);
+
+// Best of three runs, in nanoseconds per element (one push and one pop)
+static double timeRun(BenchFn fn, const uint64_t* keys, int n, uint64_t* checksum) {
+    double best = 1e30;
+    for (int rep = 0; rep < 3; rep++) {
+        double t0 = nowSeconds();
+        *checksum = fn(keys, n);
+        double t = nowSeconds() - t0;
+        if (t < best) best = t;
+    }
+    return best * 1e9 / n;
+}
+
+static void runBenchmark(int n) {
+    uint64_t* keys = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+    if (keys == NULL) return;
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < n; i++) keys[i] = nextRandom(&seed);
+
+    struct {
+        const char* payload;
+        const char* container;
+        BenchFn boxed;
+        BenchFn inlined;
+    } rows[] = {
+        {"8 B", "stack", P8StackBoxed, P8StackInline},
+        {"8 B", "ring", P8RingBoxed, P8RingInline},
+        {"8 B", "ring, push_n", P8RingBoxed, P8RingBulk},
+        {"8 B", "priority queue", P8QueueBoxed, P8QueueInline},
+        {"16 B", "stack", P16StackBoxed, P16StackInline},
+        {"16 B", "ring", P16RingBoxed, P16RingInline},
+        {"16 B", "ring, push_n", P16RingBoxed, P16RingBulk},
+        {"16 B", "priority queue", P16QueueBoxed, P16QueueInline},
+        {"64 B", "stack", P64StackBoxed, P64StackInline},
+        {"64 B", "ring", P64RingBoxed, P64RingInline},
+        {"64 B", "ring, push_n", P64RingBoxed, P64RingBulk},
+        {"64 B", "priority queue", P64QueueBoxed, P64QueueInline},
+    };
+
+    printf("%d elements, ns per element (push + pop)\n", n);
+    printf("%-8s %-16s %10s %10s %9s\n", "payload", "container", "void*", "inline", "speedup");
+    for (size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++) {
+        uint64_t boxedSum, inlineSum;
+        double boxed = timeRun(rows[i].boxed, keys, n, &boxedSum);
+        double inlined = timeRun(rows[i].inlined, keys, n, &inlineSum);
+        printf("%-8s %-16s %10.2f %10.2f %8.2fx%s\n", rows[i].payload, rows[i].container, boxed, inlined,
+               boxed / inlined, boxedSum == inlineSum ? "" : "  (checksum mismatch)");
+    }
+    free(keys);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [elements]
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        if (n < 1) n = 1;
+        runBenchmark(n);
+        return 0;
+    }
+
+    struct IdStack ids;
+    IdStack_init(&ids);
+    uint64_t batch[] = {10000000001ULL, 10000000002ULL, 10000000003ULL};
+    IdStack_push_n(&ids, batch, 3);
+    IdStack_push(&ids, 10000000004ULL);
+    uint64_t id;
+    printf("Ids popped:");
+    while (IdStack_pop(&ids, &id) == 0) printf(" %llu", (unsigned long long)id);   // ...4 ...3 ...2 ...1
+    printf("\n");
+    IdStack_destroy(&ids);
+
+    struct PointRing points;
+    PointRing_init(&points);
+    for (int i = 0; i < 20; i++) {
+        struct Point p = {i, i * i};
+        PointRing_push(&points, p);
+        if (i % 2 == 1) PointRing_pop(&points, &p);   // Keep the ring wrapping
+    }
+    struct Point out[4];
+    size_t got = PointRing_pop_n(&points, out, 4);
+    printf("Oldest points:");
+    for (size_t i = 0; i < got; i++) printf(" (%d,%d)", out[i].x, out[i].y);   // (10,100) (11,121) (12,144) (13,169)
+    printf("\n");
+    PointRing_destroy(&points);
+
+    struct JobQueue jobs;
+    JobQueue_init(&jobs);
+    struct Job pending[] = {{3, "backup"}, {1, "page oncall"}, {2, "rotate logs"}};
+    JobQueue_push_n(&jobs, pending, 3);
+    struct Job extra = {0, "stop the fire"};
+    JobQueue_push(&jobs, extra);
+    struct Job job;
+    printf("Jobs by priority:");
+    while (JobQueue_pop(&jobs, &job) == 0) printf(" [%d %s]", job.priority, job.name);
+    printf("\n");
+    JobQueue_destroy(&jobs);
+    return 0;
+}
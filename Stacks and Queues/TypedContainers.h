@@ -0,0 +1,291 @@
+#ifndef TYPED_CONTAINERS_H
+#define TYPED_CONTAINERS_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+// Macro templates for stacks, FIFO rings and priority queues of any element
+// type, stored inline.
+//
+//   DEFINE_STACK(T, name)          struct name + name_init, name_destroy,
+//                                  name_reserve, name_push, name_pop,
+//                                  name_peek, name_push_n, name_pop_n
+//   DEFINE_RING(T, name)           the same set, first in first out
+//   DEFINE_PQUEUE(T, name, LESS)   name_init, name_destroy, name_reserve,
+//                                  name_push, name_pop, name_peek,
+//                                  name_push_n; pops the element for which
+//                                  LESS(const T* a, const T* b) says "a first"
+//
+// A container of void* needs one allocation per element and a pointer chase
+// per access. Here the elements sit next to each other in one buffer, the
+// bulk calls are a memcpy, and LESS (a macro or an inline function) is
+// expanded at every comparison instead of called through a pointer.
+//
+// Containers start empty without allocating and double when full. Functions
+// return 0, or -1 when out of memory or, for pop/peek, when empty. name_peek
+// returns a pointer into the buffer (NULL if empty), valid until the next
+// push.
+
+#define TC_INITIAL_CAPACITY 16  // Also keeps ring capacities a power of two
+#define TC_PQ_ARITY_SHIFT 2     // 4-ary heap, as in PriorityQueue.c
+
+// Smallest doubling of capacity that holds at least `needed` elements
+static inline size_t tc_grow_capacity(size_t capacity, size_t needed) {
+    if (capacity < TC_INITIAL_CAPACITY) capacity = TC_INITIAL_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+    return capacity;
+}
+
+// ---------------------------------------------------------------------------
+// Stack: push_n copies values in order (the last one ends up on top);
+// pop_n takes up to n from the top and stores them in the order they were
+// pushed, so push_n(pop_n(...)) restores the stack. pop_n returns the count.
+// ---------------------------------------------------------------------------
+
+#define DEFINE_STACK(T, name)                                                                       \
+    struct name {                                                                                   \
+        T* data;                                                                                    \
+        size_t count;                                                                               \
+        size_t capacity;                                                                            \
+    };                                                                                              \
+                                                                                                    \
+    static inline void name##_init(struct name* s) {                                                \
+        s->data = NULL;                                                                             \
+        s->count = 0;                                                                               \
+        s->capacity = 0;                                                                            \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_destroy(struct name* s) {                                             \
+        free(s->data);                                                                              \
+        name##_init(s);                                                                             \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_reserve(struct name* s, size_t needed) {                               \
+        if (needed <= s->capacity) return 0;                                                        \
+        size_t capacity = tc_grow_capacity(s->capacity, needed);                                    \
+        T* data = (T*)realloc(s->data, capacity * sizeof(T));                                       \
+        if (data == NULL) return -1;                                                                \
+        s->data = data;                                                                             \
+        s->capacity = capacity;                                                                     \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push(struct name* s, T value) {                                        \
+        if (s->count == s->capacity && name##_reserve(s, s->count + 1) != 0) return -1;             \
+        s->data[s->count++] = value;                                                                \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_pop(struct name* s, T* out) {                                          \
+        if (s->count == 0) return -1;                                                               \
+        *out = s->data[--s->count];                                                                 \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline T* name##_peek(struct name* s) {                                                  \
+        return s->count > 0 ? &s->data[s->count - 1] : NULL;                                        \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push_n(struct name* s, const T* values, size_t n) {                    \
+        if (n == 0) return 0;                                                                       \
+        if (name##_reserve(s, s->count + n) != 0) return -1;                                        \
+        memcpy(s->data + s->count, values, n * sizeof(T));                                          \
+        s->count += n;                                                                              \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_pop_n(struct name* s, T* out, size_t n) {                           \
+        if (n > s->count) n = s->count;                                                             \
+        if (n == 0) return 0;                                                                       \
+        s->count -= n;                                                                              \
+        memcpy(out, s->data + s->count, n * sizeof(T));                                             \
+        return n;                                                                                   \
+    }
+
+// ---------------------------------------------------------------------------
+// Ring (FIFO queue): the live elements are `count` slots starting at `head`,
+// wrapping at the power-of-two capacity. The bulk calls copy in at most two
+// pieces, before and after the wrap point. pop_n returns the count.
+// ---------------------------------------------------------------------------
+
+#define DEFINE_RING(T, name)                                                                        \
+    struct name {                                                                                   \
+        T* data;                                                                                    \
+        size_t head;                                                                                \
+        size_t count;                                                                               \
+        size_t capacity;                                                                            \
+    };                                                                                              \
+                                                                                                    \
+    static inline void name##_init(struct name* r) {                                                \
+        r->data = NULL;                                                                             \
+        r->head = 0;                                                                                \
+        r->count = 0;                                                                               \
+        r->capacity = 0;                                                                            \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_destroy(struct name* r) {                                             \
+        free(r->data);                                                                              \
+        name##_init(r);                                                                             \
+    }                                                                                               \
+                                                                                                    \
+    /* Copy n elements out starting at logical position `from` */                                   \
+    static inline void name##_copy_out(const struct name* r, size_t from, T* out, size_t n) {       \
+        size_t start = (r->head + from) & (r->capacity - 1);                                        \
+        size_t first = r->capacity - start;                                                         \
+        if (first > n) first = n;                                                                   \
+        memcpy(out, r->data + start, first * sizeof(T));                                            \
+        memcpy(out + first, r->data, (n - first) * sizeof(T));                                      \
+    }                                                                                               \
+                                                                                                    \
+    /* Moving to a new buffer also unwraps the elements to start at 0 */                            \
+    static inline int name##_reserve(struct name* r, size_t needed) {                               \
+        if (needed <= r->capacity) return 0;                                                        \
+        size_t capacity = tc_grow_capacity(r->capacity, needed);                                    \
+        T* data = (T*)malloc(capacity * sizeof(T));                                                 \
+        if (data == NULL) return -1;                                                                \
+        if (r->count > 0) name##_copy_out(r, 0, data, r->count);                                    \
+        free(r->data);                                                                              \
+        r->data = data;                                                                             \
+        r->head = 0;                                                                                \
+        r->capacity = capacity;                                                                     \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push(struct name* r, T value) {                                        \
+        if (r->count == r->capacity && name##_reserve(r, r->count + 1) != 0) return -1;             \
+        r->data[(r->head + r->count++) & (r->capacity - 1)] = value;                                \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_pop(struct name* r, T* out) {                                          \
+        if (r->count == 0) return -1;                                                               \
+        *out = r->data[r->head];                                                                    \
+        r->head = (r->head + 1) & (r->capacity - 1);                                                \
+        r->count--;                                                                                 \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline T* name##_peek(struct name* r) {                                                  \
+        return r->count > 0 ? &r->data[r->head] : NULL;                                             \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push_n(struct name* r, const T* values, size_t n) {                    \
+        if (name##_reserve(r, r->count + n) != 0) return -1;                                        \
+        if (n == 0) return 0;                                                                       \
+        size_t start = (r->head + r->count) & (r->capacity - 1);                                    \
+        size_t first = r->capacity - start;                                                         \
+        if (first > n) first = n;                                                                   \
+        memcpy(r->data + start, values, first * sizeof(T));                                         \
+        memcpy(r->data, values + first, (n - first) * sizeof(T));                                   \
+        r->count += n;                                                                              \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_pop_n(struct name* r, T* out, size_t n) {                           \
+        if (n > r->count) n = r->count;                                                             \
+        if (n == 0) return 0;                                                                       \
+        name##_copy_out(r, 0, out, n);                                                              \
+        r->head = (r->head + n) & (r->capacity - 1);                                                \
+        r->count -= n;                                                                              \
+        return n;                                                                                   \
+    }
+
+// ---------------------------------------------------------------------------
+// Priority queue: 4-ary heap with the element LESS puts first at index 0.
+// Sifting moves a hole instead of swapping, so each level costs one copy.
+// push_n appends with memcpy and then either sifts the new elements up or,
+// when they outnumber the old ones, rebuilds the heap bottom-up in O(n).
+// ---------------------------------------------------------------------------
+
+#define DEFINE_PQUEUE(T, name, LESS)                                                                \
+    struct name {                                                                                   \
+        T* data;                                                                                    \
+        size_t count;                                                                               \
+        size_t capacity;                                                                            \
+    };                                                                                              \
+                                                                                                    \
+    static inline void name##_init(struct name* q) {                                                \
+        q->data = NULL;                                                                             \
+        q->count = 0;                                                                               \
+        q->capacity = 0;                                                                            \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_destroy(struct name* q) {                                             \
+        free(q->data);                                                                              \
+        name##_init(q);                                                                             \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_reserve(struct name* q, size_t needed) {                               \
+        if (needed <= q->capacity) return 0;                                                        \
+        size_t capacity = tc_grow_capacity(q->capacity, needed);                                    \
+        T* data = (T*)realloc(q->data, capacity * sizeof(T));                                       \
+        if (data == NULL) return -1;                                                                \
+        q->data = data;                                                                             \
+        q->capacity = capacity;                                                                     \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_sift_up(struct name* q, size_t i, T value) {                          \
+        while (i > 0) {                                                                             \
+            size_t parent = (i - 1) >> TC_PQ_ARITY_SHIFT;                                           \
+            if (!(LESS(&value, &q->data[parent]))) break;                                           \
+            q->data[i] = q->data[parent];                                                           \
+            i = parent;                                                                             \
+        }                                                                                           \
+        q->data[i] = value;                                                                         \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_sift_down(struct name* q, size_t i, T value) {                        \
+        for (;;) {                                                                                  \
+            size_t first = (i << TC_PQ_ARITY_SHIFT) + 1;                                            \
+            if (first >= q->count) break;                                                           \
+            size_t last = first + ((size_t)1 << TC_PQ_ARITY_SHIFT);                                 \
+            if (last > q->count) last = q->count;                                                   \
+            size_t best = first;                                                                    \
+            for (size_t c = first + 1; c < last; c++) {                                             \
+                if (LESS(&q->data[c], &q->data[best])) best = c;                                    \
+            }                                                                                       \
+            if (!(LESS(&q->data[best], &value))) break;                                             \
+            q->data[i] = q->data[best];                                                             \
+            i = best;                                                                               \
+        }                                                                                           \
+        q->data[i] = value;                                                                         \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push(struct name* q, T value) {                                        \
+        if (q->count == q->capacity && name##_reserve(q, q->count + 1) != 0) return -1;             \
+        name##_sift_up(q, q->count++, value);                                                       \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_pop(struct name* q, T* out) {                                          \
+        if (q->count == 0) return -1;                                                               \
+        *out = q->data[0];                                                                          \
+        T last = q->data[--q->count];                                                               \
+        if (q->count > 0) name##_sift_down(q, 0, last);                                             \
+        return 0;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline T* name##_peek(struct name* q) {                                                  \
+        return q->count > 0 ? &q->data[0] : NULL;                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push_n(struct name* q, const T* values, size_t n) {                    \
+        if (n == 0) return 0;                                                                       \
+        if (name##_reserve(q, q->count + n) != 0) return -1;                                        \
+        size_t old = q->count;                                                                      \
+        memcpy(q->data + old, values, n * sizeof(T));                                               \
+        q->count += n;                                                                              \
+        if (n > old) {                                                                              \
+            /* Floyd: sift down every parent, last one first */                                     \
+            for (size_t i = q->count > 1 ? ((q->count - 2) >> TC_PQ_ARITY_SHIFT) + 1 : 0; i-- > 0;) { \
+                name##_sift_down(q, i, q->data[i]);                                                 \
+            }                                                                                       \
+        } else {                                                                                    \
+            for (size_t i = old; i < q->count; i++) name##_sift_up(q, i, q->data[i]);               \
+        }                                                                                           \
+        return 0;                                                                                   \
+    }
+
+#endif  // TYPED_CONTAINERS_H
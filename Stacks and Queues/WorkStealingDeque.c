@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+// Work-stealing deque (Chase and Lev, "Dynamic Circular Work-Stealing Deque",
+// with the C11 orderings from Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models") and a fork-join thread pool on top.
+//
+// The deque has the DoubleEndedQuene.c shape, split between threads: the
+// owning worker pushes and pops at the bottom (insertRear / deleteRear)
+// without locks, and other workers steal from the top (deleteFront) with a
+// CAS on `top`. Only the last element can be contested by both ends. The
+// circular array doubles when full; old arrays cannot be freed while a thief
+// may still be reading them, so they are kept until the deque is destroyed
+// (together they are smaller than the final array).
+
+#define CACHE_LINE 64
+#define INITIAL_DEQUE_CAPACITY 64  // Power of two
+#define MAX_WORKERS 64
+
+struct TaskGroup;
+typedef void (*TaskFn)(void* arg);
+
+// A spawned call. The spawner owns the memory (usually a local variable) and
+// must keep it alive until pool_sync returns.
+struct Task {
+    TaskFn fn;
+    void* arg;
+    struct TaskGroup* group;
+};
+
+// Counts the spawned tasks that have not finished yet
+struct TaskGroup {
+    atomic_int pending;
+};
+
+struct DequeArray {
+    long mask;
+    struct DequeArray* retired;  // The array this one replaced
+    _Atomic(struct Task*) slots[];
+};
+
+struct WSDeque {
+    _Alignas(CACHE_LINE) atomic_long top;     // Next index to steal
+    _Alignas(CACHE_LINE) atomic_long bottom;  // Next index to push; written by the owner only
+    _Atomic(struct DequeArray*) array;
+};
+
+static struct DequeArray* newArray(long capacity) {
+    struct DequeArray* a = (struct DequeArray*)malloc(sizeof(struct DequeArray) + capacity * sizeof(struct Task*));
+    if (a == NULL) return NULL;
+    a->mask = capacity - 1;
+    a->retired = NULL;
+    return a;
+}
+
+int ws_init(struct WSDeque* d) {
+    struct DequeArray* a = newArray(INITIAL_DEQUE_CAPACITY);
+    if (a == NULL) return -1;
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    atomic_init(&d->array, a);
+    return 0;
+}
+
+// Free the array and every array it replaced. No thread may be using the deque.
+void ws_destroy(struct WSDeque* d) {
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    while (a != NULL) {
+        struct DequeArray* retired = a->retired;
+        free(a);
+        a = retired;
+    }
+}
+
+// Owner only: copy the live range [top, bottom) into an array twice the size
+static struct DequeArray* grow(struct WSDeque* d, struct DequeArray* a, long top, long bottom) {
+    struct DequeArray* bigger = newArray(2 * (a->mask + 1));
+    if (bigger == NULL) return NULL;
+    for (long i = top; i < bottom; i++) {
+        struct Task* t = atomic_load_explicit(&a->slots[i & a->mask], memory_order_relaxed);
+        atomic_store_explicit(&bigger->slots[i & bigger->mask], t, memory_order_relaxed);
+    }
+    bigger->retired = a;
+    atomic_store_explicit(&d->array, bigger, memory_order_release);
+    return bigger;
+}
+
+// Owner only: push at the bottom. Returns 0, or -1 if the array could not grow.
+int ws_push(struct WSDeque* d, struct Task* task) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    if (b - t > a->mask) {
+        a = grow(d, a, t, b);
+        if (a == NULL) return -1;
+    }
+    atomic_store_explicit(&a->slots[b & a->mask], task, memory_order_relaxed);
+    // Publishes the slot (and the task it points to) to thieves
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return 0;
+}
+
+// Owner only: pop the most recently pushed task, or NULL if empty
+struct Task* ws_pop(struct WSDeque* d) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    // Thieves must see the lowered bottom before we read top
+    atomic_thread_fence(memory_order_seq_cst);
+    long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);  // Was empty
+        return NULL;
+    }
+    struct Task* task = atomic_load_explicit(&a->slots[b & a->mask], memory_order_relaxed);
+    if (t == b) {
+        // Last element: race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Any thread: take the oldest task, or NULL if empty or another thread won it
+struct Task* ws_steal(struct WSDeque* d) {
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_acquire);
+    struct Task* task = atomic_load_explicit(&a->slots[t & a->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+// ---------------------------------------------------------------------------
+// Fork-join thread pool: one deque per worker. A worker runs its own newest
+// task first (depth first, good locality); when it has none it steals the
+// oldest task of a random victim, which is usually the biggest piece of work.
+// ---------------------------------------------------------------------------
+
+struct ThreadPool;
+
+struct Worker {
+    struct WSDeque deque;
+    struct ThreadPool* pool;
+    uint64_t seed;         // For picking victims
+    int id;
+    pthread_t thread;
+} __attribute__((aligned(CACHE_LINE)));
+
+struct ThreadPool {
+    struct Worker* workers;
+    int count;
+    atomic_int active;          // A pool_run is in progress
+    int stop;
+    unsigned generation;        // Bumped by every pool_run, under lock
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        // Idle workers sleep here between runs
+};
+
+static _Thread_local struct Worker* currentWorker;
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void runTask(struct Task* task) {
+    struct TaskGroup* group = task->group;
+    task->fn(task->arg);
+    // The spawner may free the task as soon as this is seen
+    atomic_fetch_sub_explicit(&group->pending, 1, memory_order_release);
+}
+
+// Own newest task, or a stolen one
+static struct Task* findWork(struct Worker* self) {
+    struct Task* task = ws_pop(&self->deque);
+    if (task != NULL || self->pool->count == 1) return task;
+    struct ThreadPool* pool = self->pool;
+    for (int attempt = 0; attempt < 2 * pool->count; attempt++) {
+        int victim = (int)(nextRandom(&self->seed) % (uint64_t)(pool->count - 1));
+        if (victim >= self->id) victim++;  // Never ourselves
+        task = ws_steal(&pool->workers[victim].deque);
+        if (task != NULL) return task;
+    }
+    return NULL;
+}
+
+static void* workerMain(void* arg) {
+    struct Worker* self = (struct Worker*)arg;
+    struct ThreadPool* pool = self->pool;
+    unsigned seen = 0;
+    currentWorker = self;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        seen = pool->generation;
+        int stop = pool->stop;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop) break;
+
+        while (atomic_load_explicit(&pool->active, memory_order_acquire)) {
+            struct Task* task = findWork(self);
+            if (task != NULL) {
+                runTask(task);
+            } else {
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+// Start a pool of `threads` workers; the thread calling pool_run is worker 0.
+// Returns 0, or -1 if out of memory or no thread could be started.
+int pool_init(struct ThreadPool* pool, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > MAX_WORKERS) threads = MAX_WORKERS;
+    pool->workers = (struct Worker*)aligned_alloc(CACHE_LINE, (size_t)threads * sizeof(struct Worker));
+    if (pool->workers == NULL) return -1;
+    pool->count = 0;
+    pool->stop = 0;
+    pool->generation = 0;
+    atomic_init(&pool->active, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    for (int i = 0; i < threads; i++) {
+        struct Worker* w = &pool->workers[i];
+        if (ws_init(&w->deque) != 0) break;
+        w->pool = pool;
+        w->id = i;
+        w->seed = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+        if (i > 0 && pthread_create(&w->thread, NULL, workerMain, w) != 0) {
+            ws_destroy(&w->deque);
+            break;
+        }
+        pool->count++;
+    }
+    if (pool->count == 0) {
+        free(pool->workers);
+        return -1;
+    }
+    return 0;  // With fewer workers than asked for if some failed to start
+}
+
+void pool_destroy(struct ThreadPool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i < pool->count; i++) pthread_join(pool->workers[i].thread, NULL);
+    // Only now can no thread be reading another worker's deque
+    for (int i = 0; i < pool->count; i++) ws_destroy(&pool->workers[i].deque);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    free(pool->workers);
+    pool->workers = NULL;
+}
+
+void group_init(struct TaskGroup* group) {
+    atomic_init(&group->pending, 0);
+}
+
+// From inside a pool task: make fn(arg) available to run in parallel with the
+// caller. `task` is caller-owned storage that must outlive the pool_sync.
+void pool_spawn(struct TaskGroup* group, struct Task* task, TaskFn fn, void* arg) {
+    task->fn = fn;
+    task->arg = arg;
+    task->group = group;
+    atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+    if (ws_push(&currentWorker->deque, task) != 0) {
+        runTask(task);  // No room to defer it: run it now
+    }
+}
+
+// From inside a pool task: wait for every task spawned into group, running
+// other work (own or stolen) in the meantime instead of blocking
+void pool_sync(struct TaskGroup* group) {
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) > 0) {
+        struct Task* task = findWork(currentWorker);
+        if (task != NULL) {
+            runTask(task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+// Run fn(arg) on the pool from outside it and return when it is done. Tasks
+// must sync what they spawn before returning (fork-join), so everything has
+// finished when fn returns. Not reentrant; one pool_run at a time.
+void pool_run(struct ThreadPool* pool, TaskFn fn, void* arg) {
+    pthread_mutex_lock(&pool->lock);
+    atomic_store_explicit(&pool->active, 1, memory_order_release);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    struct Worker* outer = currentWorker;
+    currentWorker = &pool->workers[0];
+    fn(arg);
+    currentWorker = outer;
+    atomic_store_explicit(&pool->active, 0, memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: recursive Fibonacci, spawning one branch at every level above a
+// cutoff, on 1 .. all cores
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long long fibSerial(int n) {
+    return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+struct FibArgs {
+    int n;
+    int cutoff;       // Below this, recurse serially
+    long long result;
+};
+
+static void fibTask(void* arg) {
+    struct FibArgs* a = (struct FibArgs*)arg;
+    if (a->n < a->cutoff || a->n < 2) {
+        a->result = fibSerial(a->n);
+        return;
+    }
+    struct FibArgs left = {a->n - 1, a->cutoff, 0};
+    struct FibArgs right = {a->n - 2, a->cutoff, 0};
+    struct TaskGroup group;
+    struct Task task;
+    group_init(&group);
+    pool_spawn(&group, &task, fibTask, &left);
+    fibTask(&right);
+    pool_sync(&group);
+    a->result = left.result + right.result;
+}
+
+// Tasks spawned by fibTask(n): one per call with n >= cutoff
+static long long spawnCount(int n, int cutoff) {
+    if (n < cutoff || n < 2) return 0;
+    return 1 + spawnCount(n - 1, cutoff) + spawnCount(n - 2, cutoff);
+}
+
+static void runBenchmark(int n, int maxThreads) {
+    double t0 = nowSeconds();
+    long long expected = fibSerial(n);
+    double serial = nowSeconds() - t0;
+    printf("fib(%d) = %lld, plain recursion %.3f s (speedups below are against 1 worker)\n\n", n, expected, serial);
+
+    int cutoffs[] = {2, 20};   // Every call spawns / coarse leaves
+    for (int c = 0; c < 2; c++) {
+        int cutoff = cutoffs[c] < n ? cutoffs[c] : n;
+        long long tasks = spawnCount(n, cutoff);
+        double oneThread = 0;
+        printf("cutoff %d: %lld spawns\n", cutoff, tasks);
+        printf("%8s %10s %10s %14s\n", "threads", "seconds", "speedup", "spawns/sec");
+        for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+            struct ThreadPool pool;
+            if (pool_init(&pool, threads) != 0) break;
+            struct FibArgs args = {n, cutoff, 0};
+            t0 = nowSeconds();
+            pool_run(&pool, fibTask, &args);
+            double elapsed = nowSeconds() - t0;
+            pool_destroy(&pool);
+            if (threads == 1) oneThread = elapsed;
+            printf("%8d %10.3f %10.2f %14.0f%s\n", threads, elapsed, oneThread / elapsed, tasks / elapsed,
+                   args.result == expected ? "" : "  (wrong result)");
+            if (threads == maxThreads) break;
+        }
+        printf("\n");
+    }
+}
+
+struct Range {
+    const int* values;
+    int count;
+    long long sum;
+};
+
+// Split in halves until the pieces are small, spawning the left half
+static void sumRange(void* arg) {
+    struct Range* r = (struct Range*)arg;
+    if (r->count <= 1000) {
+        r->sum = 0;
+        for (int i = 0; i < r->count; i++) r->sum += r->values[i];
+        return;
+    }
+    struct Range left = {r->values, r->count / 2, 0};
+    struct Range right = {r->values + r->count / 2, r->count - r->count / 2, 0};
+    struct TaskGroup group;
+    struct Task task;
+    group_init(&group);
+    pool_spawn(&group, &task, sumRange, &left);
+    sumRange(&right);
+    pool_sync(&group);
+    r->sum = left.sum + right.sum;
+}
+
+int main(int argc, char* argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [n] [max threads]
+        int n = argc > 2 ? atoi(argv[2]) : 36;
+        int maxThreads = argc > 3 ? atoi(argv[3]) : (int)(cpus > 0 ? cpus : 1);
+        if (maxThreads < 1) maxThreads = 1;
+        if (maxThreads > MAX_WORKERS) maxThreads = MAX_WORKERS;
+        runBenchmark(n, maxThreads);
+        return 0;
+    }
+
+    // The deque on its own: the owner works at the bottom, a thief at the top
+    struct WSDeque d;
+    struct Task tasks[3];
+    ws_init(&d);
+    for (int i = 0; i < 3; i++) ws_push(&d, &tasks[i]);
+    printf("Popped task %d\n", (int)(ws_pop(&d) - tasks));     // 2 (newest)
+    printf("Stolen task %d\n", (int)(ws_steal(&d) - tasks));   // 0 (oldest)
+    ws_destroy(&d);
+
+    // A parallel sum with spawn/sync
+    int n = 1000000;
+    int* values = (int*)malloc((size_t)n * sizeof(int));
+    for (int i = 0; i < n; i++) values[i] = i % 100;
+    struct ThreadPool pool;
+    pool_init(&pool, cpus > 1 ? (int)cpus : 2);
+    struct Range all = {values, n, 0};
+    pool_run(&pool, sumRange, &all);
+    printf("Sum on %d workers: %lld\n", pool.count, all.sum);   // 49500000
+    pool_destroy(&pool);
+    free(values);
+    return 0;
+}
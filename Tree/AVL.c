@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// AVL tree in C, ported from AVL.py, without recursion.
+//
+// Nodes live in one growable array (the arena) and refer to their children by
+// 32-bit index instead of by pointer, which halves the link size and keeps
+// nodes packed together. Index 0 is a sentinel standing for "no node" with
+// height 0, so the height of an empty subtree needs no special case.
+
+#define NIL 0
+#define INITIAL_CAPACITY 64
+// An AVL tree with 2^32 nodes is at most 1.44 * 32 levels deep
+#define AVL_MAX_HEIGHT 48
+
+struct AVLNode {
+    int value;
+    uint32_t left;
+    uint32_t right;
+    int height;
+};
+
+struct AVLTree {
+    struct AVLNode* nodes;  // The arena; nodes[0] is the sentinel
+    uint32_t capacity;
+    uint32_t used;          // Arena slots handed out so far (including the sentinel)
+    uint32_t freeList;      // Deleted nodes, chained through their left index
+    uint32_t root;
+    uint32_t size;          // Number of values in the tree
+};
+
+int initTree(struct AVLTree* tree) {
+    tree->nodes = (struct AVLNode*)malloc(INITIAL_CAPACITY * sizeof(struct AVLNode));
+    if (tree->nodes == NULL) return -1;
+    memset(&tree->nodes[NIL], 0, sizeof(struct AVLNode));
+    tree->capacity = INITIAL_CAPACITY;
+    tree->used = 1;
+    tree->freeList = NIL;
+    tree->root = NIL;
+    tree->size = 0;
+    return 0;
+}
+
+// Free the whole tree at once
+void destroyTree(struct AVLTree* tree) {
+    free(tree->nodes);
+    tree->nodes = NULL;
+    tree->root = NIL;
+    tree->size = 0;
+}
+
+// Take a node from the free list or the arena. Growing the arena may move it,
+// so callers hold indices, never pointers, across this call.
+static uint32_t createNode(struct AVLTree* tree, int value) {
+    uint32_t index;
+    if (tree->freeList != NIL) {
+        index = tree->freeList;
+        tree->freeList = tree->nodes[index].left;
+    } else {
+        if (tree->used == tree->capacity) {
+            if (tree->capacity > UINT32_MAX / 2) return NIL;
+            uint32_t capacity = tree->capacity * 2;
+            struct AVLNode* nodes = (struct AVLNode*)realloc(tree->nodes, capacity * sizeof(struct AVLNode));
+            if (nodes == NULL) return NIL;
+            tree->nodes = nodes;
+            tree->capacity = capacity;
+        }
+        index = tree->used++;
+    }
+    struct AVLNode* node = &tree->nodes[index];
+    node->value = value;
+    node->left = NIL;
+    node->right = NIL;
+    node->height = 1;
+    return index;
+}
+
+static void freeNode(struct AVLTree* tree, uint32_t index) {
+    tree->nodes[index].left = tree->freeList;
+    tree->freeList = index;
+}
+
+static int height(const struct AVLTree* tree, uint32_t index) {
+    return tree->nodes[index].height;
+}
+
+static void updateHeight(struct AVLTree* tree, uint32_t index) {
+    int lh = height(tree, tree->nodes[index].left);
+    int rh = height(tree, tree->nodes[index].right);
+    tree->nodes[index].height = (lh > rh ? lh : rh) + 1;
+}
+
+static int balance_factor(const struct AVLTree* tree, uint32_t index) {
+    return height(tree, tree->nodes[index].left) - height(tree, tree->nodes[index].right);
+}
+
+static uint32_t rotate_right(struct AVLTree* tree, uint32_t y) {
+    uint32_t x = tree->nodes[y].left;
+    uint32_t T2 = tree->nodes[x].right;
+
+    tree->nodes[x].right = y;
+    tree->nodes[y].left = T2;
+
+    updateHeight(tree, y);
+    updateHeight(tree, x);
+
+    return x;
+}
+
+static uint32_t rotate_left(struct AVLTree* tree, uint32_t x) {
+    uint32_t y = tree->nodes[x].right;
+    uint32_t T2 = tree->nodes[y].left;
+
+    tree->nodes[y].left = x;
+    tree->nodes[x].right = T2;
+
+    updateHeight(tree, x);
+    updateHeight(tree, y);
+
+    return y;
+}
+
+// Restore the AVL property at one node; returns the new root of that subtree
+static uint32_t rebalance(struct AVLTree* tree, uint32_t index) {
+    updateHeight(tree, index);
+    int balance = balance_factor(tree, index);
+
+    if (balance > 1) {
+        // Left-right case becomes left-left first
+        if (balance_factor(tree, tree->nodes[index].left) < 0) {
+            tree->nodes[index].left = rotate_left(tree, tree->nodes[index].left);
+        }
+        return rotate_right(tree, index);
+    }
+    if (balance < -1) {
+        // Right-left case becomes right-right first
+        if (balance_factor(tree, tree->nodes[index].right) > 0) {
+            tree->nodes[index].right = rotate_right(tree, tree->nodes[index].right);
+        }
+        return rotate_left(tree, index);
+    }
+    return index;
+}
+
+// Walk back up a recorded root-to-node path, rebalancing each node and
+// relinking it to its parent. Insertion can stop as soon as a subtree's
+// height is unchanged; deletion has to go all the way.
+static void fixPath(struct AVLTree* tree, uint32_t* path, int depth, int stopWhenStable) {
+    while (depth-- > 0) {
+        uint32_t index = path[depth];
+        int oldHeight = height(tree, index);
+        uint32_t subtree = rebalance(tree, index);
+
+        if (depth == 0) {
+            tree->root = subtree;
+        } else if (tree->nodes[path[depth - 1]].left == index) {
+            tree->nodes[path[depth - 1]].left = subtree;
+        } else {
+            tree->nodes[path[depth - 1]].right = subtree;
+        }
+
+        if (stopWhenStable && subtree == index && height(tree, index) == oldHeight) {
+            break;
+        }
+    }
+}
+
+// Insert a value. Returns 1 if inserted, 0 if it was already present, -1 if out of memory.
+int insert_avl(struct AVLTree* tree, int value) {
+    uint32_t path[AVL_MAX_HEIGHT];
+    int depth = 0;
+
+    // Descend to the insertion point, remembering the path
+    uint32_t current = tree->root;
+    while (current != NIL) {
+        path[depth++] = current;
+        if (value < tree->nodes[current].value) {
+            current = tree->nodes[current].left;
+        } else if (value > tree->nodes[current].value) {
+            current = tree->nodes[current].right;
+        } else {
+            return 0;
+        }
+    }
+
+    uint32_t node = createNode(tree, value);
+    if (node == NIL) return -1;
+    if (depth == 0) {
+        tree->root = node;
+    } else if (value < tree->nodes[path[depth - 1]].value) {
+        tree->nodes[path[depth - 1]].left = node;
+    } else {
+        tree->nodes[path[depth - 1]].right = node;
+    }
+    tree->size++;
+
+    fixPath(tree, path, depth, 1);
+    return 1;
+}
+
+// Return 1 if the value is in the tree
+int search_avl(const struct AVLTree* tree, int value) {
+    uint32_t current = tree->root;
+    while (current != NIL) {
+        const struct AVLNode* node = &tree->nodes[current];
+        if (value == node->value) return 1;
+        current = value < node->value ? node->left : node->right;
+    }
+    return 0;
+}
+
+// Delete a value. Returns 1 if it was removed, 0 if it was not present.
+int delete_avl(struct AVLTree* tree, int value) {
+    uint32_t path[AVL_MAX_HEIGHT];
+    int depth = 0;
+
+    uint32_t current = tree->root;
+    while (current != NIL && tree->nodes[current].value != value) {
+        path[depth++] = current;
+        current = value < tree->nodes[current].value ? tree->nodes[current].left : tree->nodes[current].right;
+    }
+    if (current == NIL) return 0;
+
+    // A node with two children takes its in-order successor's value,
+    // and the successor (which has no left child) is removed instead
+    if (tree->nodes[current].left != NIL && tree->nodes[current].right != NIL) {
+        uint32_t target = current;
+        path[depth++] = current;
+        current = tree->nodes[current].right;
+        while (tree->nodes[current].left != NIL) {
+            path[depth++] = current;
+            current = tree->nodes[current].left;
+        }
+        tree->nodes[target].value = tree->nodes[current].value;
+    }
+
+    // Splice out the node, which has at most one child
+    uint32_t child = tree->nodes[current].left != NIL ? tree->nodes[current].left : tree->nodes[current].right;
+    if (depth == 0) {
+        tree->root = child;
+    } else if (tree->nodes[path[depth - 1]].left == current) {
+        tree->nodes[path[depth - 1]].left = child;
+    } else {
+        tree->nodes[path[depth - 1]].right = child;
+    }
+    freeNode(tree, current);
+    tree->size--;
+
+    fixPath(tree, path, depth, 0);
+    return 1;
+}
+
+// In-order iterator with an explicit stack of pending ancestors
+struct AVLIterator {
+    const struct AVLTree* tree;
+    uint32_t stack[AVL_MAX_HEIGHT];
+    int top;
+};
+
+static void pushLeftSpine(struct AVLIterator* it, uint32_t index) {
+    while (index != NIL) {
+        it->stack[it->top++] = index;
+        index = it->tree->nodes[index].left;
+    }
+}
+
+void iteratorInit(struct AVLIterator* it, const struct AVLTree* tree) {
+    it->tree = tree;
+    it->top = 0;
+    pushLeftSpine(it, tree->root);
+}
+
+// Start at the smallest value >= key
+void iteratorSeek(struct AVLIterator* it, const struct AVLTree* tree, int key) {
+    it->tree = tree;
+    it->top = 0;
+    uint32_t current = tree->root;
+    while (current != NIL) {
+        if (key <= tree->nodes[current].value) {
+            it->stack[it->top++] = current;  // current and its right subtree come later
+            current = tree->nodes[current].left;
+        } else {
+            current = tree->nodes[current].right;
+        }
+    }
+}
+
+// Store the next value in ascending order; returns 0 when the iteration is over
+int iteratorNext(struct AVLIterator* it, int* value) {
+    if (it->top == 0) return 0;
+    uint32_t index = it->stack[--it->top];
+    *value = it->tree->nodes[index].value;
+    pushLeftSpine(it, it->tree->nodes[index].right);
+    return 1;
+}
+
+void inOrderTraversal(const struct AVLTree* tree) {
+    struct AVLIterator it;
+    int value;
+    iteratorInit(&it, tree);
+    while (iteratorNext(&it, &value)) {
+        printf("%d ", value);
+    }
+    printf("\n");
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: against the recursive, malloc-per-node BST from README.md
+// ---------------------------------------------------------------------------
+
+struct Node {
+    int val;
+    struct Node* left;
+    struct Node* right;
+};
+
+static struct Node* bstInsert(struct Node* node, int key) {
+    if (node == NULL) {
+        struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
+        newNode->val = key;
+        newNode->left = newNode->right = NULL;
+        return newNode;
+    }
+    if (key < node->val)
+        node->left = bstInsert(node->left, key);
+    else if (key > node->val)
+        node->right = bstInsert(node->right, key);
+    return node;
+}
+
+static struct Node* bstSearch(struct Node* root, int key) {
+    if (root == NULL || root->val == key)
+        return root;
+    if (key < root->val)
+        return bstSearch(root->left, key);
+    return bstSearch(root->right, key);
+}
+
+static void bstFree(struct Node* node) {
+    if (node != NULL) {
+        bstFree(node->left);
+        bstFree(node->right);
+        free(node);
+    }
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// Sorted input turns the plain BST into a list (quadratic time, recursion as
+// deep as the tree), so it is only run on this many keys
+#define SORTED_BST_LIMIT 20000
+
+static void benchOne(const char* label, const int* keys, int n, int lookups, int runBst) {
+    struct AVLTree tree;
+    unsigned int seed = 4242;
+    int found = 0;
+
+    initTree(&tree);
+    double t0 = nowSeconds();
+    for (int i = 0; i < n; i++) insert_avl(&tree, keys[i]);
+    double avlInsert = nowSeconds() - t0;
+    t0 = nowSeconds();
+    for (int i = 0; i < lookups; i++) found += search_avl(&tree, keys[nextRandom(&seed) % (unsigned int)n]);
+    double avlSearch = nowSeconds() - t0;
+    printf("%-8s %-10s %10d %14.0f %14.0f\n", label, "avl", n, n / avlInsert, lookups / avlSearch);
+    destroyTree(&tree);
+
+    if (runBst) {
+        struct Node* root = NULL;
+        seed = 4242;
+        t0 = nowSeconds();
+        for (int i = 0; i < n; i++) root = bstInsert(root, keys[i]);
+        double bstInsertTime = nowSeconds() - t0;
+        t0 = nowSeconds();
+        for (int i = 0; i < lookups; i++) found -= bstSearch(root, keys[nextRandom(&seed) % (unsigned int)n]) != NULL;
+        double bstSearchTime = nowSeconds() - t0;
+        printf("%-8s %-10s %10d %14.0f %14.0f\n", label, "plain bst", n, n / bstInsertTime, lookups / bstSearchTime);
+        bstFree(root);
+        if (found != 0) printf("lookup mismatch\n");
+    }
+}
+
+static void runBenchmark(int n) {
+    int* keys = (int*)calloc((size_t)n, sizeof(int));
+    unsigned int seed = 1;
+    int lookups = 1000000;
+
+    printf("%-8s %-10s %10s %14s %14s\n", "input", "tree", "keys", "inserts/sec", "lookups/sec");
+    for (int i = 0; i < n; i++) keys[i] = (int)(nextRandom(&seed) >> 1);
+    benchOne("random", keys, n, lookups, 1);
+
+    for (int i = 0; i < n; i++) keys[i] = i;
+    benchOne("sorted", keys, n, lookups, 0);
+    benchOne("sorted", keys, n < SORTED_BST_LIMIT ? n : SORTED_BST_LIMIT, lookups / 100, 1);
+    free(keys);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+
+    struct AVLTree tree;
+    initTree(&tree);
+
+    // Sorted input stays balanced
+    for (int value = 10; value <= 100; value += 10) {
+        insert_avl(&tree, value);
+    }
+    printf("In-order traversal: ");
+    inOrderTraversal(&tree);
+    printf("Root: %d, height: %d\n", tree.nodes[tree.root].value, height(&tree, tree.root));
+
+    printf("Searching for 60: %s\n", search_avl(&tree, 60) ? "Found" : "Not Found");
+
+    delete_avl(&tree, 40);
+    delete_avl(&tree, 80);
+    printf("After deleting 40 and 80: ");
+    inOrderTraversal(&tree);
+
+    struct AVLIterator it;
+    int value;
+    printf("Values from 55 upwards: ");
+    iteratorSeek(&it, &tree, 55);
+    while (iteratorNext(&it, &value)) {
+        printf("%d ", value);
+    }
+    printf("\n");
+
+    destroyTree(&tree);
+    return 0;
+}
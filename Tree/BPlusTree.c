@@ -0,0 +1,739 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Disk-backed B+ tree (see the B+ Tree section of README.md).
+//
+// The tree lives in a file that is memory-mapped, one node per 4 KB page, so
+// the operating system's page cache decides which nodes are in RAM. Internal
+// nodes hold only keys and child page numbers; all key/value pairs are in the
+// leaves, which are linked left to right for range scans. Page 0 holds the
+// metadata. Nodes refer to each other by page number, never by pointer,
+// because growing the file remaps it at a new address.
+//
+// POSIX only (mmap, ftruncate, posix_fadvise).
+
+#define PAGE_SIZE 4096
+#define BPT_MAGIC 0x31545042u  // "BPT1"
+#define NO_PAGE 0              // Page 0 is the metadata page, so it is never a node
+#define MAX_DEPTH 16           // 511^16 keys is far beyond any file
+
+struct MetaPage {
+    uint32_t magic;
+    uint32_t pageSize;
+    uint32_t root;        // Page number of the root node
+    uint32_t pageCount;   // Pages in use, including the metadata page
+    uint32_t freeList;    // Released pages, chained through their first word
+    uint32_t height;      // 1 when the root is a leaf
+    uint64_t keyCount;
+};
+
+struct NodeHeader {
+    uint16_t isLeaf;
+    uint16_t count;   // Keys in the node
+    uint32_t next;    // Leaves: the next leaf to the right, NO_PAGE for the last one
+};
+
+#define LEAF_MAX ((PAGE_SIZE - sizeof(struct NodeHeader)) / (2 * sizeof(int32_t)))
+#define INTERNAL_MAX ((PAGE_SIZE - sizeof(struct NodeHeader) - sizeof(uint32_t)) / (sizeof(int32_t) + sizeof(uint32_t)))
+#define LEAF_MIN (LEAF_MAX / 2)
+#define INTERNAL_MIN (INTERNAL_MAX / 2)
+#define BULK_LOAD_FILL 90  // Percent of a node filled by bulk loading, leaving room for inserts
+
+struct LeafPage {
+    struct NodeHeader header;
+    int32_t keys[LEAF_MAX];
+    int32_t values[LEAF_MAX];
+};
+
+// children[i] covers the keys k with keys[i - 1] <= k < keys[i]
+struct InternalPage {
+    struct NodeHeader header;
+    int32_t keys[INTERNAL_MAX];
+    uint32_t children[INTERNAL_MAX + 1];
+};
+
+struct BPlusTree {
+    int fd;
+    char* map;          // The mapped file
+    size_t mapSize;
+};
+
+static struct MetaPage* meta(struct BPlusTree* tree) {
+    return (struct MetaPage*)tree->map;
+}
+
+static struct LeafPage* leafPage(struct BPlusTree* tree, uint32_t page) {
+    return (struct LeafPage*)(tree->map + (size_t)page * PAGE_SIZE);
+}
+
+static struct InternalPage* internalPage(struct BPlusTree* tree, uint32_t page) {
+    return (struct InternalPage*)(tree->map + (size_t)page * PAGE_SIZE);
+}
+
+static int isLeaf(struct BPlusTree* tree, uint32_t page) {
+    return leafPage(tree, page)->header.isLeaf;
+}
+
+// Grow the file (at least doubling it) and map it again at its new size
+static int remapFile(struct BPlusTree* tree, size_t needed) {
+    size_t size = tree->mapSize;
+    while (size < needed) {
+        size *= 2;
+    }
+    if (ftruncate(tree->fd, (off_t)size) != 0) return -1;
+    char* map = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, tree->fd, 0);
+    if (map == MAP_FAILED) return -1;
+    munmap(tree->map, tree->mapSize);
+    tree->map = map;
+    tree->mapSize = size;
+    return 0;
+}
+
+// Get a page for a new node. May remap the file, so any page pointers the
+// caller holds must be fetched again afterwards.
+static uint32_t allocPage(struct BPlusTree* tree, int leaf) {
+    uint32_t page = meta(tree)->freeList;
+    if (page != NO_PAGE) {
+        meta(tree)->freeList = *(uint32_t*)(tree->map + (size_t)page * PAGE_SIZE);
+    } else {
+        page = meta(tree)->pageCount;
+        if ((size_t)(page + 1) * PAGE_SIZE > tree->mapSize &&
+            remapFile(tree, (size_t)(page + 1) * PAGE_SIZE) != 0) {
+            return NO_PAGE;
+        }
+        meta(tree)->pageCount++;
+    }
+    struct NodeHeader* header = &leafPage(tree, page)->header;
+    header->isLeaf = (uint16_t)leaf;
+    header->count = 0;
+    header->next = NO_PAGE;
+    return page;
+}
+
+static void freePage(struct BPlusTree* tree, uint32_t page) {
+    *(uint32_t*)(tree->map + (size_t)page * PAGE_SIZE) = meta(tree)->freeList;
+    meta(tree)->freeList = page;
+}
+
+// Open a tree file, creating an empty tree if the file is new or `create` is set.
+// Returns 0 on success, -1 on failure.
+int bptOpen(struct BPlusTree* tree, const char* path, int create) {
+    tree->fd = open(path, O_RDWR | O_CREAT | (create ? O_TRUNC : 0), 0644);
+    if (tree->fd < 0) return -1;
+    struct stat st;
+    fstat(tree->fd, &st);
+    int fresh = st.st_size < 2 * PAGE_SIZE;
+    tree->mapSize = fresh ? 16 * PAGE_SIZE : (size_t)st.st_size;
+    if (fresh && ftruncate(tree->fd, (off_t)tree->mapSize) != 0) {
+        close(tree->fd);
+        return -1;
+    }
+    tree->map = (char*)mmap(NULL, tree->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, tree->fd, 0);
+    if (tree->map == MAP_FAILED) {
+        close(tree->fd);
+        return -1;
+    }
+    if (fresh) {
+        // Page 1 is an empty root leaf
+        struct MetaPage* m = meta(tree);
+        m->magic = BPT_MAGIC;
+        m->pageSize = PAGE_SIZE;
+        m->pageCount = 1;
+        m->freeList = NO_PAGE;
+        m->keyCount = 0;
+        m->height = 1;
+        m->root = allocPage(tree, 1);
+    } else if (meta(tree)->magic != BPT_MAGIC || meta(tree)->pageSize != PAGE_SIZE) {
+        munmap(tree->map, tree->mapSize);
+        close(tree->fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Flush dirty pages to disk
+void bptSync(struct BPlusTree* tree) {
+    msync(tree->map, tree->mapSize, MS_SYNC);
+}
+
+void bptClose(struct BPlusTree* tree) {
+    bptSync(tree);
+    munmap(tree->map, tree->mapSize);
+    close(tree->fd);
+    tree->map = NULL;
+}
+
+// First index in keys[0..n) whose key is >= key. The loop has no data-dependent
+// branch: each step halves the range with a conditional move.
+static int lowerBound(const int32_t* keys, int n, int32_t key) {
+    const int32_t* base = keys;
+    if (n == 0) return 0;
+    while (n > 1) {
+        int half = n / 2;
+        base = (base[half] < key) ? base + half : base;
+        n -= half;
+    }
+    return (int)(base - keys) + (*base < key);
+}
+
+// First index in keys[0..n) whose key is > key
+static int upperBound(const int32_t* keys, int n, int32_t key) {
+    const int32_t* base = keys;
+    if (n == 0) return 0;
+    while (n > 1) {
+        int half = n / 2;
+        base = (base[half] <= key) ? base + half : base;
+        n -= half;
+    }
+    return (int)(base - keys) + (*base <= key);
+}
+
+// Descend from the root to the leaf that should hold key. The pages visited and
+// the child index taken in each are recorded; returns the depth of the leaf.
+static int findLeaf(struct BPlusTree* tree, int32_t key, uint32_t* pages, int* indexes) {
+    uint32_t page = meta(tree)->root;
+    int depth = 0;
+    while (!isLeaf(tree, page)) {
+        struct InternalPage* node = internalPage(tree, page);
+        int i = upperBound(node->keys, node->header.count, key);
+        pages[depth] = page;
+        indexes[depth] = i;
+        depth++;
+        page = node->children[i];
+    }
+    pages[depth] = page;
+    return depth;
+}
+
+// Point lookup. Returns 1 and stores the value if the key is present.
+int bptSearch(struct BPlusTree* tree, int32_t key, int32_t* value) {
+    uint32_t page = meta(tree)->root;
+    while (!isLeaf(tree, page)) {
+        struct InternalPage* node = internalPage(tree, page);
+        page = node->children[upperBound(node->keys, node->header.count, key)];
+    }
+    struct LeafPage* leaf = leafPage(tree, page);
+    int i = lowerBound(leaf->keys, leaf->header.count, key);
+    if (i < leaf->header.count && leaf->keys[i] == key) {
+        *value = leaf->values[i];
+        return 1;
+    }
+    return 0;
+}
+
+// Insert (separator, rightChild) into the parents along the path, splitting
+// full internal nodes and growing a new root when the old one splits.
+static int insertIntoParents(struct BPlusTree* tree, uint32_t* pages, int* indexes, int depth,
+                             int32_t separator, uint32_t rightChild) {
+    while (depth > 0) {
+        depth--;
+        uint32_t page = pages[depth];
+        int at = indexes[depth];
+        struct InternalPage* node = internalPage(tree, page);
+        int count = node->header.count;
+
+        if (count < (int)INTERNAL_MAX) {
+            memmove(node->keys + at + 1, node->keys + at, (count - at) * sizeof(int32_t));
+            memmove(node->children + at + 2, node->children + at + 1, (count - at) * sizeof(uint32_t));
+            node->keys[at] = separator;
+            node->children[at + 1] = rightChild;
+            node->header.count++;
+            return 0;
+        }
+
+        // Split a full node: gather all keys and children, keep the lower half,
+        // move the upper half to a new page and push the middle key up
+        int32_t keys[INTERNAL_MAX + 1];
+        uint32_t children[INTERNAL_MAX + 2];
+        memcpy(keys, node->keys, at * sizeof(int32_t));
+        keys[at] = separator;
+        memcpy(keys + at + 1, node->keys + at, (count - at) * sizeof(int32_t));
+        memcpy(children, node->children, (at + 1) * sizeof(uint32_t));
+        children[at + 1] = rightChild;
+        memcpy(children + at + 2, node->children + at + 1, (count - at) * sizeof(uint32_t));
+
+        uint32_t rightPage = allocPage(tree, 0);
+        if (rightPage == NO_PAGE) return -1;
+        node = internalPage(tree, page);
+        struct InternalPage* right = internalPage(tree, rightPage);
+        int total = count + 1;
+        int mid = total / 2;
+        node->header.count = (uint16_t)mid;
+        memcpy(node->keys, keys, mid * sizeof(int32_t));
+        memcpy(node->children, children, (mid + 1) * sizeof(uint32_t));
+        right->header.count = (uint16_t)(total - mid - 1);
+        memcpy(right->keys, keys + mid + 1, right->header.count * sizeof(int32_t));
+        memcpy(right->children, children + mid + 1, (right->header.count + 1) * sizeof(uint32_t));
+
+        separator = keys[mid];
+        rightChild = rightPage;
+    }
+
+    // The root split: the tree grows by one level
+    uint32_t rootPage = allocPage(tree, 0);
+    if (rootPage == NO_PAGE) return -1;
+    struct InternalPage* root = internalPage(tree, rootPage);
+    root->header.count = 1;
+    root->keys[0] = separator;
+    root->children[0] = meta(tree)->root;
+    root->children[1] = rightChild;
+    meta(tree)->root = rootPage;
+    meta(tree)->height++;
+    return 0;
+}
+
+// Insert or update a key. Returns 1 if inserted, 0 if updated, -1 on failure.
+int bptInsert(struct BPlusTree* tree, int32_t key, int32_t value) {
+    uint32_t pages[MAX_DEPTH];
+    int indexes[MAX_DEPTH];
+    int depth = findLeaf(tree, key, pages, indexes);
+    uint32_t page = pages[depth];
+    struct LeafPage* leaf = leafPage(tree, page);
+    int count = leaf->header.count;
+    int at = lowerBound(leaf->keys, count, key);
+
+    if (at < count && leaf->keys[at] == key) {
+        leaf->values[at] = value;
+        return 0;
+    }
+
+    if (count < (int)LEAF_MAX) {
+        memmove(leaf->keys + at + 1, leaf->keys + at, (count - at) * sizeof(int32_t));
+        memmove(leaf->values + at + 1, leaf->values + at, (count - at) * sizeof(int32_t));
+        leaf->keys[at] = key;
+        leaf->values[at] = value;
+        leaf->header.count++;
+        meta(tree)->keyCount++;
+        return 1;
+    }
+
+    // Split a full leaf in two and link the new one after it
+    int32_t keys[LEAF_MAX + 1];
+    int32_t values[LEAF_MAX + 1];
+    memcpy(keys, leaf->keys, at * sizeof(int32_t));
+    memcpy(values, leaf->values, at * sizeof(int32_t));
+    keys[at] = key;
+    values[at] = value;
+    memcpy(keys + at + 1, leaf->keys + at, (count - at) * sizeof(int32_t));
+    memcpy(values + at + 1, leaf->values + at, (count - at) * sizeof(int32_t));
+
+    uint32_t rightPage = allocPage(tree, 1);
+    if (rightPage == NO_PAGE) return -1;
+    leaf = leafPage(tree, page);
+    struct LeafPage* right = leafPage(tree, rightPage);
+    int total = count + 1;
+    int mid = total / 2;
+    leaf->header.count = (uint16_t)mid;
+    memcpy(leaf->keys, keys, mid * sizeof(int32_t));
+    memcpy(leaf->values, values, mid * sizeof(int32_t));
+    right->header.count = (uint16_t)(total - mid);
+    memcpy(right->keys, keys + mid, right->header.count * sizeof(int32_t));
+    memcpy(right->values, values + mid, right->header.count * sizeof(int32_t));
+    right->header.next = leaf->header.next;
+    leaf->header.next = rightPage;
+    meta(tree)->keyCount++;
+
+    if (insertIntoParents(tree, pages, indexes, depth, right->keys[0], rightPage) != 0) return -1;
+    return 1;
+}
+
+// Remove key `at` and child `at + 1` from an internal node
+static void removeFromInternal(struct InternalPage* node, int at) {
+    int count = node->header.count;
+    memmove(node->keys + at, node->keys + at + 1, (count - at - 1) * sizeof(int32_t));
+    memmove(node->children + at + 1, node->children + at + 2, (count - at - 1) * sizeof(uint32_t));
+    node->header.count--;
+}
+
+// Fix an underfull leaf at pages[depth] by borrowing from or merging with a sibling.
+// Returns 1 if the parent lost an entry (and may now be underfull itself).
+static int rebalanceLeaf(struct BPlusTree* tree, uint32_t* pages, int* indexes, int depth) {
+    struct InternalPage* parent = internalPage(tree, pages[depth - 1]);
+    int i = indexes[depth - 1];
+    struct LeafPage* leaf = leafPage(tree, pages[depth]);
+
+    if (i > 0) {
+        struct LeafPage* left = leafPage(tree, parent->children[i - 1]);
+        if (left->header.count > LEAF_MIN) {
+            // Borrow the largest entry of the left sibling
+            memmove(leaf->keys + 1, leaf->keys, leaf->header.count * sizeof(int32_t));
+            memmove(leaf->values + 1, leaf->values, leaf->header.count * sizeof(int32_t));
+            left->header.count--;
+            leaf->keys[0] = left->keys[left->header.count];
+            leaf->values[0] = left->values[left->header.count];
+            leaf->header.count++;
+            parent->keys[i - 1] = leaf->keys[0];
+            return 0;
+        }
+    }
+    if (i < parent->header.count) {
+        struct LeafPage* right = leafPage(tree, parent->children[i + 1]);
+        if (right->header.count > LEAF_MIN) {
+            // Borrow the smallest entry of the right sibling
+            leaf->keys[leaf->header.count] = right->keys[0];
+            leaf->values[leaf->header.count] = right->values[0];
+            leaf->header.count++;
+            right->header.count--;
+            memmove(right->keys, right->keys + 1, right->header.count * sizeof(int32_t));
+            memmove(right->values, right->values + 1, right->header.count * sizeof(int32_t));
+            parent->keys[i] = right->keys[0];
+            return 0;
+        }
+    }
+
+    // Neither sibling can spare an entry: merge the right node of the pair into the left
+    int sep = i > 0 ? i - 1 : i;
+    uint32_t rightPage = parent->children[sep + 1];
+    struct LeafPage* left = leafPage(tree, parent->children[sep]);
+    struct LeafPage* right = leafPage(tree, rightPage);
+    memcpy(left->keys + left->header.count, right->keys, right->header.count * sizeof(int32_t));
+    memcpy(left->values + left->header.count, right->values, right->header.count * sizeof(int32_t));
+    left->header.count += right->header.count;
+    left->header.next = right->header.next;
+    freePage(tree, rightPage);
+    removeFromInternal(parent, sep);
+    return 1;
+}
+
+// Same as rebalanceLeaf for an internal node; separators rotate through the parent
+static int rebalanceInternal(struct BPlusTree* tree, uint32_t* pages, int* indexes, int depth) {
+    struct InternalPage* parent = internalPage(tree, pages[depth - 1]);
+    int i = indexes[depth - 1];
+    struct InternalPage* node = internalPage(tree, pages[depth]);
+
+    if (i > 0) {
+        struct InternalPage* left = internalPage(tree, parent->children[i - 1]);
+        if (left->header.count > INTERNAL_MIN) {
+            memmove(node->keys + 1, node->keys, node->header.count * sizeof(int32_t));
+            memmove(node->children + 1, node->children, (node->header.count + 1) * sizeof(uint32_t));
+            node->keys[0] = parent->keys[i - 1];
+            node->children[0] = left->children[left->header.count];
+            node->header.count++;
+            parent->keys[i - 1] = left->keys[left->header.count - 1];
+            left->header.count--;
+            return 0;
+        }
+    }
+    if (i < parent->header.count) {
+        struct InternalPage* right = internalPage(tree, parent->children[i + 1]);
+        if (right->header.count > INTERNAL_MIN) {
+            node->keys[node->header.count] = parent->keys[i];
+            node->children[node->header.count + 1] = right->children[0];
+            node->header.count++;
+            parent->keys[i] = right->keys[0];
+            memmove(right->keys, right->keys + 1, (right->header.count - 1) * sizeof(int32_t));
+            memmove(right->children, right->children + 1, right->header.count * sizeof(uint32_t));
+            right->header.count--;
+            return 0;
+        }
+    }
+
+    int sep = i > 0 ? i - 1 : i;
+    uint32_t rightPage = parent->children[sep + 1];
+    struct InternalPage* left = internalPage(tree, parent->children[sep]);
+    struct InternalPage* right = internalPage(tree, rightPage);
+    left->keys[left->header.count] = parent->keys[sep];
+    memcpy(left->keys + left->header.count + 1, right->keys, right->header.count * sizeof(int32_t));
+    memcpy(left->children + left->header.count + 1, right->children, (right->header.count + 1) * sizeof(uint32_t));
+    left->header.count += right->header.count + 1;
+    freePage(tree, rightPage);
+    removeFromInternal(parent, sep);
+    return 1;
+}
+
+// Delete a key. Returns 1 if it was removed, 0 if it was not present.
+int bptDelete(struct BPlusTree* tree, int32_t key) {
+    uint32_t pages[MAX_DEPTH];
+    int indexes[MAX_DEPTH];
+    int depth = findLeaf(tree, key, pages, indexes);
+    struct LeafPage* leaf = leafPage(tree, pages[depth]);
+    int count = leaf->header.count;
+    int at = lowerBound(leaf->keys, count, key);
+    if (at == count || leaf->keys[at] != key) return 0;
+
+    memmove(leaf->keys + at, leaf->keys + at + 1, (count - at - 1) * sizeof(int32_t));
+    memmove(leaf->values + at, leaf->values + at + 1, (count - at - 1) * sizeof(int32_t));
+    leaf->header.count--;
+    meta(tree)->keyCount--;
+
+    if (depth == 0 || leaf->header.count >= LEAF_MIN) return 1;
+
+    // Rebalance upwards while merges keep leaving parents underfull
+    int shrunk = rebalanceLeaf(tree, pages, indexes, depth);
+    while (shrunk && --depth > 0 && internalPage(tree, pages[depth])->header.count < INTERNAL_MIN) {
+        shrunk = rebalanceInternal(tree, pages, indexes, depth);
+    }
+
+    // A root left with a single child is replaced by that child
+    struct InternalPage* root = internalPage(tree, meta(tree)->root);
+    if (!root->header.isLeaf && root->header.count == 0) {
+        uint32_t oldRoot = meta(tree)->root;
+        meta(tree)->root = root->children[0];
+        meta(tree)->height--;
+        freePage(tree, oldRoot);
+    }
+    return 1;
+}
+
+// Build the tree from keys sorted in ascending order, without duplicates.
+// The tree must be empty. Leaves are written left to right, then each internal
+// level is built from the one below it. Returns 0 on success.
+int bptBulkLoad(struct BPlusTree* tree, const int32_t* keys, const int32_t* values, size_t n) {
+    if (meta(tree)->keyCount != 0) return -1;
+    if (n == 0) return 0;
+
+    // Spread the keys evenly so the last node is not left nearly empty
+    size_t perLeaf = LEAF_MAX * BULK_LOAD_FILL / 100;
+    size_t leaves = (n + perLeaf - 1) / perLeaf;
+    uint32_t* level = (uint32_t*)malloc(leaves * sizeof(uint32_t));
+    int32_t* minKeys = (int32_t*)malloc(leaves * sizeof(int32_t));
+    if (level == NULL || minKeys == NULL) {
+        free(level);
+        free(minKeys);
+        return -1;
+    }
+
+    // Size the file once instead of doubling it repeatedly
+    size_t estimate = (size_t)meta(tree)->pageCount + leaves + leaves / (INTERNAL_MAX / 2) + 16;
+    if (estimate * PAGE_SIZE > tree->mapSize) remapFile(tree, estimate * PAGE_SIZE);
+
+    uint32_t firstLeaf = meta(tree)->root;  // Reuse the empty root leaf
+    size_t done = 0;
+    for (size_t l = 0; l < leaves; l++) {
+        uint32_t page = (l == 0) ? firstLeaf : allocPage(tree, 1);
+        if (page == NO_PAGE) {
+            free(level);
+            free(minKeys);
+            return -1;
+        }
+        size_t take = (n - done) / (leaves - l);
+        struct LeafPage* leaf = leafPage(tree, page);
+        memcpy(leaf->keys, keys + done, take * sizeof(int32_t));
+        memcpy(leaf->values, values + done, take * sizeof(int32_t));
+        leaf->header.count = (uint16_t)take;
+        leaf->header.next = NO_PAGE;
+        if (l > 0) leafPage(tree, level[l - 1])->header.next = page;
+        level[l] = page;
+        minKeys[l] = keys[done];
+        done += take;
+    }
+
+    // Each pass groups the nodes of one level under new parents
+    size_t count = leaves;
+    uint32_t height = 1;
+    size_t perNode = INTERNAL_MAX * BULK_LOAD_FILL / 100 + 1;  // Children per internal node
+    while (count > 1) {
+        size_t parents = (count + perNode - 1) / perNode;
+        size_t child = 0;
+        for (size_t p = 0; p < parents; p++) {
+            uint32_t page = allocPage(tree, 0);
+            if (page == NO_PAGE) {
+                free(level);
+                free(minKeys);
+                return -1;
+            }
+            size_t take = (count - child) / (parents - p);
+            struct InternalPage* node = internalPage(tree, page);
+            for (size_t c = 0; c < take; c++) {
+                node->children[c] = level[child + c];
+                if (c > 0) node->keys[c - 1] = minKeys[child + c];
+            }
+            node->header.count = (uint16_t)(take - 1);
+            level[p] = page;
+            minKeys[p] = minKeys[child];
+            child += take;
+        }
+        count = parents;
+        height++;
+    }
+
+    meta(tree)->root = level[0];
+    meta(tree)->height = height;
+    meta(tree)->keyCount = n;
+    free(level);
+    free(minKeys);
+    return 0;
+}
+
+// Cursor for range scans along the linked leaves
+struct BPTCursor {
+    struct BPlusTree* tree;
+    uint32_t page;
+    int index;
+};
+
+// Position the cursor at the first key >= key
+void bptSeek(struct BPTCursor* cursor, struct BPlusTree* tree, int32_t key) {
+    uint32_t pages[MAX_DEPTH];
+    int indexes[MAX_DEPTH];
+    int depth = findLeaf(tree, key, pages, indexes);
+    struct LeafPage* leaf = leafPage(tree, pages[depth]);
+    cursor->tree = tree;
+    cursor->page = pages[depth];
+    cursor->index = lowerBound(leaf->keys, leaf->header.count, key);
+}
+
+// Read the next pair in key order; returns 0 at the end of the tree
+int bptNext(struct BPTCursor* cursor, int32_t* key, int32_t* value) {
+    while (cursor->page != NO_PAGE) {
+        struct LeafPage* leaf = leafPage(cursor->tree, cursor->page);
+        if (cursor->index < leaf->header.count) {
+            *key = leaf->keys[cursor->index];
+            *value = leaf->values[cursor->index];
+            cursor->index++;
+            return 1;
+        }
+        cursor->page = leaf->header.next;
+        cursor->index = 0;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: lookups with a cold and a warm page cache
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double timeLookups(struct BPlusTree* tree, size_t n, int lookups) {
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    int32_t value;
+    int hits = 0;
+    double t0 = nowSeconds();
+    for (int i = 0; i < lookups; i++) {
+        int32_t key = (int32_t)(nextRandom(&seed) % (2 * n));  // Only even keys exist
+        hits += bptSearch(tree, key, &value);
+    }
+    double elapsed = nowSeconds() - t0;
+    if (hits == 0) printf("no hits\n");
+    return lookups / elapsed;
+}
+
+static void runBenchmark(const char* path, size_t n) {
+    struct BPlusTree tree;
+    int32_t* keys = (int32_t*)malloc(n * sizeof(int32_t));
+    int32_t* values = (int32_t*)malloc(n * sizeof(int32_t));
+    int lookups = 1000000;
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = (int32_t)(2 * i);
+        values[i] = (int32_t)i;
+    }
+
+    if (bptOpen(&tree, path, 1) != 0) {
+        printf("Cannot open %s\n", path);
+        return;
+    }
+    double t0 = nowSeconds();
+    bptBulkLoad(&tree, keys, values, n);
+    bptSync(&tree);
+    double load = nowSeconds() - t0;
+    printf("%zu keys in %s: %u pages, height %u, bulk load %.2f s\n",
+           n, path, meta(&tree)->pageCount, meta(&tree)->height, load);
+    bptClose(&tree);
+    free(keys);
+    free(values);
+
+    // Ask the kernel to drop the file's clean pages so the next pass starts cold
+    int fd = open(path, O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+
+    bptOpen(&tree, path, 0);
+    printf("%-24s %14s\n", "pass", "lookups/sec");
+    printf("%-24s %14.0f\n", "cold page cache", timeLookups(&tree, n, lookups));
+    printf("%-24s %14.0f\n", "warm page cache", timeLookups(&tree, n, lookups));
+
+    // Range scan over the whole tree
+    struct BPTCursor cursor;
+    int32_t key, value;
+    size_t scanned = 0;
+    t0 = nowSeconds();
+    bptSeek(&cursor, &tree, 0);
+    while (bptNext(&cursor, &key, &value)) scanned++;
+    double scan = nowSeconds() - t0;
+    printf("%-24s %14.0f keys/sec\n", "full range scan", scanned / scan);
+
+    // Random updates: insert odd keys and delete even ones
+    uint64_t seed = 12345;
+    int updates = 1000000;
+    t0 = nowSeconds();
+    for (int i = 0; i < updates; i++) {
+        int32_t k = (int32_t)(nextRandom(&seed) % (2 * n));
+        if (k & 1) {
+            bptInsert(&tree, k, i);
+        } else {
+            bptDelete(&tree, k);
+        }
+    }
+    double update = nowSeconds() - t0;
+    printf("%-24s %14.0f ops/sec\n", "random insert/delete", updates / update);
+
+    bptClose(&tree);
+    unlink(path);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        size_t n = argc > 2 ? (size_t)atoll(argv[2]) : 100000000;
+        runBenchmark(argc > 3 ? argv[3] : "bplustree.db", n);
+        return 0;
+    }
+
+    const char* path = "bplustree_demo.db";
+    struct BPlusTree tree;
+    if (bptOpen(&tree, path, 1) != 0) {
+        printf("Cannot open %s\n", path);
+        return 1;
+    }
+
+    // Enough keys to split the root leaf several times
+    for (int i = 0; i < 2000; i++) {
+        bptInsert(&tree, (i * 7919) % 2000, i);
+    }
+    printf("Keys: %llu, height: %u\n", (unsigned long long)meta(&tree)->keyCount, meta(&tree)->height);
+
+    int32_t key, value;
+    if (bptSearch(&tree, 1234, &value)) {
+        printf("Searching for 1234: Found (value %d)\n", value);
+    }
+
+    for (int i = 0; i < 2000; i += 2) {
+        bptDelete(&tree, i);
+    }
+    printf("Keys after deleting the even ones: %llu\n", (unsigned long long)meta(&tree)->keyCount);
+
+    struct BPTCursor cursor;
+    printf("Range [100, 120]: ");
+    bptSeek(&cursor, &tree, 100);
+    while (bptNext(&cursor, &key, &value) && key <= 120) {
+        printf("%d ", key);
+    }
+    printf("\n");
+
+    bptClose(&tree);
+
+    // Reopen the file: the tree is still there
+    bptOpen(&tree, path, 0);
+    printf("After reopening, 1999 is %s\n", bptSearch(&tree, 1999, &value) ? "Found" : "Not Found");
+    bptClose(&tree);
+    unlink(path);
+    return 0;
+}
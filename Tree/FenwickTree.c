@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// Fenwick tree (binary indexed tree) over an int array, see the Fenwick Tree
+// section of README.md.
+//
+// tree[i] (1-based) holds the sum of the i & -i elements ending at element i,
+// so both a point update and a prefix sum touch O(log n) entries. Only sums
+// are supported; range minimum and maximum need the segment tree in
+// SegmentTree.c because they cannot be undone by subtraction.
+
+struct FenwickTree {
+    int n;
+    long long* tree;  // n + 1 entries, tree[0] unused
+};
+
+// Half-open range [l, r), used by rangeSum_many
+struct RangeQuery {
+    int l, r;
+};
+
+// Turn tree[1..n], holding the plain values, into a Fenwick tree in O(n):
+// every entry adds itself into the one entry that covers it next
+static void buildInPlace(long long* tree, int n) {
+    for (int i = 1; i <= n; i++) {
+        int parent = i + (i & -i);
+        if (parent <= n) tree[parent] += tree[i];
+    }
+}
+
+// The inverse of buildInPlace: recover the plain values in O(n)
+static void unbuildInPlace(long long* tree, int n) {
+    for (int i = n; i >= 1; i--) {
+        int parent = i + (i & -i);
+        if (parent <= n) tree[parent] -= tree[i];
+    }
+}
+
+// Build over values[0..n) in O(n). Returns 0, or -1 if out of memory.
+int initFenwick(struct FenwickTree* ft, const int* values, int n) {
+    ft->n = n;
+    ft->tree = (long long*)malloc(((size_t)n + 1) * sizeof(long long));
+    if (ft->tree == NULL) return -1;
+    ft->tree[0] = 0;
+    for (int i = 0; i < n; i++) ft->tree[i + 1] = values[i];
+    buildInPlace(ft->tree, n);
+    return 0;
+}
+
+void destroyFenwick(struct FenwickTree* ft) {
+    free(ft->tree);
+    ft->tree = NULL;
+    ft->n = 0;
+}
+
+// Add delta to element i. Returns 0, or -1 if i is out of range.
+int fenwickAdd(struct FenwickTree* ft, int i, int delta) {
+    if (i < 0 || i >= ft->n) return -1;
+    for (i++; i <= ft->n; i += i & -i) {
+        ft->tree[i] += delta;
+    }
+    return 0;
+}
+
+// Sum of elements [0, i), or 0 if i is not in [0, n]
+long long prefixSum(struct FenwickTree* ft, int i) {
+    if (i < 0 || i > ft->n) return 0;
+    long long sum = 0;
+    for (; i > 0; i -= i & -i) {
+        sum += ft->tree[i];
+    }
+    return sum;
+}
+
+// Sum of elements [l, r), or 0 for an invalid range (as in rangeSum_many)
+long long rangeSum(struct FenwickTree* ft, int l, int r) {
+    if (l < 0 || r > ft->n || l > r) return 0;
+    return prefixSum(ft, r) - prefixSum(ft, l);
+}
+
+// Smallest i such that prefixSum(i + 1) >= target, or n if there is none.
+// Needs non-negative elements. Walks down by powers of two in O(log n).
+int fenwickLowerBound(struct FenwickTree* ft, long long target) {
+    int pos = 0;
+    int step = 1;
+    while (step * 2 <= ft->n) step *= 2;
+    for (; step > 0; step /= 2) {
+        if (pos + step <= ft->n && ft->tree[pos + step] < target) {
+            pos += step;
+            target -= ft->tree[pos];
+        }
+    }
+    return pos;
+}
+
+// ---------------------------------------------------------------------------
+// Batch operations
+// ---------------------------------------------------------------------------
+
+// A batch at least n / BATCH_LINEAR_DIVISOR long is handled with O(n) passes
+// over the whole array instead of O(log n) scattered accesses per item
+#define BATCH_LINEAR_DIVISOR 16
+
+// Apply count point updates. A large batch takes the tree back to plain values,
+// adds the deltas directly and rebuilds, reading memory sequentially.
+// Returns the number of indices that were out of range.
+int fenwickAdd_many(struct FenwickTree* ft, const int* indices, const int* deltas, int count) {
+    int failures = 0;
+    int linear = count >= ft->n / BATCH_LINEAR_DIVISOR;
+    if (linear) unbuildInPlace(ft->tree, ft->n);
+    for (int k = 0; k < count; k++) {
+        int i = indices[k];
+        if (i < 0 || i >= ft->n) {
+            failures++;
+        } else if (linear) {
+            ft->tree[i + 1] += deltas[k];
+        } else {
+            fenwickAdd(ft, i, deltas[k]);
+        }
+    }
+    if (linear) buildInPlace(ft->tree, ft->n);
+    return failures;
+}
+
+// Sum each range [l, r) into results[]. A large batch first computes every
+// prefix sum in one O(n) pass; each query is then two array reads.
+// Returns the number of invalid ranges (their result is 0).
+int rangeSum_many(struct FenwickTree* ft, const struct RangeQuery* queries, int count, long long* results) {
+    int failures = 0;
+    long long* prefix = NULL;
+    if (count >= ft->n / BATCH_LINEAR_DIVISOR) {
+        prefix = (long long*)malloc(((size_t)ft->n + 1) * sizeof(long long));
+    }
+    if (prefix != NULL) {
+        memcpy(prefix, ft->tree, ((size_t)ft->n + 1) * sizeof(long long));
+        unbuildInPlace(prefix, ft->n);
+        for (int i = 1; i <= ft->n; i++) prefix[i] += prefix[i - 1];
+    }
+    for (int k = 0; k < count; k++) {
+        int l = queries[k].l, r = queries[k].r;
+        if (l < 0 || r > ft->n || l > r) {
+            results[k] = 0;
+            failures++;
+        } else if (prefix != NULL) {
+            results[k] = prefix[r] - prefix[l];
+        } else {
+            results[k] = rangeSum(ft, l, r);
+        }
+    }
+    free(prefix);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void runBenchmark(int n, int ops) {
+    struct FenwickTree ft;
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    long long checksum = 0;
+
+    int* values = (int*)malloc((size_t)n * sizeof(int));
+    int* indices = (int*)malloc((size_t)ops * sizeof(int));
+    int* deltas = (int*)malloc((size_t)ops * sizeof(int));
+    struct RangeQuery* queries = (struct RangeQuery*)malloc((size_t)ops * sizeof(struct RangeQuery));
+    long long* results = (long long*)malloc((size_t)ops * sizeof(long long));
+    if (values == NULL || indices == NULL || deltas == NULL || queries == NULL || results == NULL) {
+        printf("n = %d skipped: not enough memory\n", n);
+        free(values); free(indices); free(deltas); free(queries); free(results);
+        return;
+    }
+    for (int i = 0; i < n; i++) values[i] = (int)(nextRandom(&seed) % 1000);
+    for (int k = 0; k < ops; k++) {
+        indices[k] = (int)(nextRandom(&seed) % (uint64_t)n);
+        deltas[k] = (int)(nextRandom(&seed) % 7) - 3;
+        int a = (int)(nextRandom(&seed) % ((uint64_t)n + 1));
+        int b = (int)(nextRandom(&seed) % ((uint64_t)n + 1));
+        queries[k].l = a < b ? a : b;
+        queries[k].r = a < b ? b : a;
+    }
+
+    double t0 = nowSeconds();
+    if (initFenwick(&ft, values, n) != 0) {
+        printf("n = %d skipped: not enough memory\n", n);
+        free(values); free(indices); free(deltas); free(queries); free(results);
+        return;
+    }
+    double build = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (int k = 0; k < ops; k++) {
+        checksum += rangeSum(&ft, queries[k].l, queries[k].r);
+    }
+    double query = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    rangeSum_many(&ft, queries, ops, results);
+    double queryBatch = nowSeconds() - t0;
+    for (int k = 0; k < ops; k++) checksum -= results[k];
+
+    t0 = nowSeconds();
+    for (int k = 0; k < ops; k++) {
+        fenwickAdd(&ft, indices[k], deltas[k]);
+    }
+    double add = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    fenwickAdd_many(&ft, indices, deltas, ops);
+    double addBatch = nowSeconds() - t0;
+
+    if (checksum != 0) printf("batch results differ from single queries\n");
+    printf("n = %d, %d operations of each kind (batch path: %s)\n", n, ops,
+           ops >= n / BATCH_LINEAR_DIVISOR ? "linear pass" : "per item");
+    printf("  %-24s %14.3f s\n", "build", build);
+    printf("  %-24s %14s\n", "operation", "ops/sec");
+    printf("  %-24s %14.0f\n", "rangeSum", ops / query);
+    printf("  %-24s %14.0f\n", "rangeSum_many", ops / queryBatch);
+    printf("  %-24s %14.0f\n", "fenwickAdd", ops / add);
+    printf("  %-24s %14.0f\n", "fenwickAdd_many", ops / addBatch);
+
+    destroyFenwick(&ft);
+    free(values); free(indices); free(deltas); free(queries); free(results);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [n...]: defaults to 1M and 100M elements, with 10M operations
+        int ops = 10000000;
+        if (argc > 2) {
+            for (int i = 2; i < argc; i++) runBenchmark(atoi(argv[i]), ops);
+        } else {
+            runBenchmark(1000000, ops);
+            runBenchmark(100000000, ops);
+        }
+        return 0;
+    }
+
+    int values[] = {5, 3, 8, 6, 1, 4, 7, 2};
+    int n = sizeof(values) / sizeof(values[0]);
+    struct FenwickTree ft;
+    initFenwick(&ft, values, n);
+
+    printf("Sum of [0, 8): %lld\n", rangeSum(&ft, 0, 8));
+    printf("Sum of [2, 6): %lld\n", rangeSum(&ft, 2, 6));
+
+    fenwickAdd(&ft, 3, 10);
+    printf("After adding 10 to element 3, sum of [2, 6): %lld\n", rangeSum(&ft, 2, 6));
+
+    // First position where the running total reaches 20
+    printf("Prefix sum reaches 20 at index %d\n", fenwickLowerBound(&ft, 20));
+
+    int indices[] = {0, 7, 7};
+    int deltas[] = {1, 1, 1};
+    fenwickAdd_many(&ft, indices, deltas, 3);
+    struct RangeQuery queries[] = {{0, 1}, {4, 8}, {0, 8}};
+    long long results[3];
+    rangeSum_many(&ft, queries, 3, results);
+    for (int i = 0; i < 3; i++) {
+        printf("Sum of [%d, %d): %lld\n", queries[i].l, queries[i].r, results[i]);
+    }
+
+    destroyFenwick(&ft);
+    return 0;
+}
@@ -0,0 +1,489 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+
+// Segment tree over an int array (see the Segment Tree section of README.md).
+//
+// The tree is stored bottom-up in arrays of 2 * size entries, where size is the
+// smallest power of two >= n: node 1 is the root, the children of node k are
+// 2k and 2k + 1, and element i is leaf size + i. Every operation walks the
+// two boundary paths of the range in loops, with no recursion.
+//
+// Each node keeps the sum, minimum and maximum of its range, so one query
+// returns all three. Range updates are lazy: an update is recorded on the
+// O(log n) nodes covering the range and pushed down to their children only
+// when a later operation passes through them. Values and pending adds are
+// int; the sums are long long.
+
+#define UPDATE_ADD 0
+#define UPDATE_ASSIGN 1
+
+struct SegmentTree {
+    int n;
+    int size;             // Number of leaves, a power of two
+    int log;              // size == 1 << log
+    long long* sum;       // 2 * size entries
+    int* min;
+    int* max;
+    int* addTag;          // Internal nodes only: add pending for both children
+    int* assignTag;       // Internal nodes only: assignment pending for both children
+    unsigned char* hasAssign;
+};
+
+struct RangeResult {
+    long long sum;
+    int min;
+    int max;
+};
+
+// Half-open ranges [l, r), used by the batch functions
+struct RangeQuery {
+    int l, r;
+};
+
+struct RangeUpdate {
+    int l, r;
+    int kind;     // UPDATE_ADD or UPDATE_ASSIGN
+    int value;
+};
+
+// Recompute node k from its children
+static void pull(struct SegmentTree* st, int k) {
+    int a = 2 * k, b = 2 * k + 1;
+    st->sum[k] = st->sum[a] + st->sum[b];
+    st->min[k] = st->min[a] < st->min[b] ? st->min[a] : st->min[b];
+    st->max[k] = st->max[a] > st->max[b] ? st->max[a] : st->max[b];
+}
+
+// Apply an update to the whole of node k, which covers len elements
+static void applyNode(struct SegmentTree* st, int k, int kind, int value, int len) {
+    if (kind == UPDATE_ASSIGN) {
+        st->sum[k] = (long long)value * len;
+        st->min[k] = st->max[k] = value;
+        if (k < st->size) {
+            st->hasAssign[k] = 1;
+            st->assignTag[k] = value;
+            st->addTag[k] = 0;
+        }
+    } else {
+        st->sum[k] += (long long)value * len;
+        st->min[k] += value;
+        st->max[k] += value;
+        if (k < st->size) {
+            // An add after an assignment folds into the assigned value
+            if (st->hasAssign[k]) {
+                st->assignTag[k] += value;
+            } else {
+                st->addTag[k] += value;
+            }
+        }
+    }
+}
+
+// Hand the pending updates of node k (covering len elements) to its children
+static void push(struct SegmentTree* st, int k, int len) {
+    if (st->hasAssign[k]) {
+        applyNode(st, 2 * k, UPDATE_ASSIGN, st->assignTag[k], len / 2);
+        applyNode(st, 2 * k + 1, UPDATE_ASSIGN, st->assignTag[k], len / 2);
+        st->hasAssign[k] = 0;
+    }
+    if (st->addTag[k] != 0) {
+        applyNode(st, 2 * k, UPDATE_ADD, st->addTag[k], len / 2);
+        applyNode(st, 2 * k + 1, UPDATE_ADD, st->addTag[k], len / 2);
+        st->addTag[k] = 0;
+    }
+}
+
+// Push pending updates down the paths to leaves l and r - 1, top to bottom.
+// Nodes entirely inside [l, r) are left alone. The node at height i covers 1 << i leaves.
+static void pushBoundaries(struct SegmentTree* st, int l, int r) {
+    for (int i = st->log; i >= 1; i--) {
+        if (((l >> i) << i) != l) push(st, l >> i, 1 << i);
+        if (((r >> i) << i) != r) push(st, (r - 1) >> i, 1 << i);
+    }
+}
+
+// Build the tree over values[0..n) in O(n). Returns 0, or -1 if out of memory.
+int initSegmentTree(struct SegmentTree* st, const int* values, int n) {
+    st->n = n;
+    st->size = 1;
+    st->log = 0;
+    while (st->size < n) {
+        st->size *= 2;
+        st->log++;
+    }
+    size_t nodes = 2 * (size_t)st->size;
+    st->sum = (long long*)malloc(nodes * sizeof(long long));
+    st->min = (int*)malloc(nodes * sizeof(int));
+    st->max = (int*)malloc(nodes * sizeof(int));
+    st->addTag = (int*)calloc(st->size, sizeof(int));
+    st->assignTag = (int*)calloc(st->size, sizeof(int));
+    st->hasAssign = (unsigned char*)calloc(st->size, 1);
+    if (st->sum == NULL || st->min == NULL || st->max == NULL ||
+        st->addTag == NULL || st->assignTag == NULL || st->hasAssign == NULL) {
+        free(st->sum); free(st->min); free(st->max);
+        free(st->addTag); free(st->assignTag); free(st->hasAssign);
+        return -1;
+    }
+    // Padding leaves past n hold 0; no query or update ever covers them alone
+    for (int i = 0; i < st->size; i++) {
+        int v = i < n ? values[i] : 0;
+        st->sum[st->size + i] = v;
+        st->min[st->size + i] = st->max[st->size + i] = v;
+    }
+    for (int k = st->size - 1; k >= 1; k--) {
+        pull(st, k);
+    }
+    return 0;
+}
+
+void destroySegmentTree(struct SegmentTree* st) {
+    free(st->sum); free(st->min); free(st->max);
+    free(st->addTag); free(st->assignTag); free(st->hasAssign);
+    st->sum = NULL;
+    st->n = st->size = 0;
+}
+
+// Apply an add or an assignment to [l, r). Returns 0, or -1 for an invalid range.
+int rangeUpdate(struct SegmentTree* st, int l, int r, int kind, int value) {
+    if (l < 0 || r > st->n || l > r) return -1;
+    if (l == r) return 0;
+    l += st->size;
+    r += st->size;
+    pushBoundaries(st, l, r);
+
+    // Walk up from both ends, updating the nodes that exactly tile [l, r)
+    int lo = l, hi = r, len = 1;
+    while (lo < hi) {
+        if (lo & 1) applyNode(st, lo++, kind, value, len);
+        if (hi & 1) applyNode(st, --hi, kind, value, len);
+        lo >>= 1;
+        hi >>= 1;
+        len <<= 1;
+    }
+
+    // Refresh the ancestors of the updated nodes, bottom to top
+    for (int i = 1; i <= st->log; i++) {
+        if (((l >> i) << i) != l) pull(st, l >> i);
+        if (((r >> i) << i) != r) pull(st, (r - 1) >> i);
+    }
+    return 0;
+}
+
+int rangeAdd(struct SegmentTree* st, int l, int r, int delta) {
+    return rangeUpdate(st, l, r, UPDATE_ADD, delta);
+}
+
+int rangeAssign(struct SegmentTree* st, int l, int r, int value) {
+    return rangeUpdate(st, l, r, UPDATE_ASSIGN, value);
+}
+
+// Sum, minimum and maximum of [l, r). An empty range gives sum 0, min INT_MAX
+// and max INT_MIN. Returns 0, or -1 for an invalid range.
+int rangeQuery(struct SegmentTree* st, int l, int r, struct RangeResult* result) {
+    result->sum = 0;
+    result->min = INT_MAX;
+    result->max = INT_MIN;
+    if (l < 0 || r > st->n || l > r) return -1;
+    if (l == r) return 0;
+    l += st->size;
+    r += st->size;
+    pushBoundaries(st, l, r);
+    while (l < r) {
+        if (l & 1) {
+            result->sum += st->sum[l];
+            if (st->min[l] < result->min) result->min = st->min[l];
+            if (st->max[l] > result->max) result->max = st->max[l];
+            l++;
+        }
+        if (r & 1) {
+            r--;
+            result->sum += st->sum[r];
+            if (st->min[r] < result->min) result->min = st->min[r];
+            if (st->max[r] > result->max) result->max = st->max[r];
+        }
+        l >>= 1;
+        r >>= 1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Batch operations
+// ---------------------------------------------------------------------------
+
+#define BATCH_SORT_MIN 64  // Smaller batches are not worth sorting
+
+// Positions 0..count-1 ordered by left endpoint, using an LSD radix sort on
+// the endpoint (stable, three passes of 11 bits). Returns NULL if out of memory.
+static int* orderByLeft(const int* lefts, size_t stride, int count) {
+    int* order = (int*)malloc((size_t)count * sizeof(int));
+    int* scratch = (int*)malloc((size_t)count * sizeof(int));
+    if (order == NULL || scratch == NULL) {
+        free(order);
+        free(scratch);
+        return NULL;
+    }
+    for (int i = 0; i < count; i++) order[i] = i;
+    for (int shift = 0; shift < 33; shift += 11) {
+        int counts[2049] = {0};
+        for (int i = 0; i < count; i++) {
+            unsigned l = (unsigned)*(const int*)((const char*)lefts + (size_t)order[i] * stride);
+            counts[((l >> shift) & 2047) + 1]++;
+        }
+        for (int d = 0; d < 2048; d++) counts[d + 1] += counts[d];
+        for (int i = 0; i < count; i++) {
+            unsigned l = (unsigned)*(const int*)((const char*)lefts + (size_t)order[i] * stride);
+            scratch[counts[(l >> shift) & 2047]++] = order[i];
+        }
+        int* swap = order;
+        order = scratch;
+        scratch = swap;
+    }
+    free(scratch);
+    return order;
+}
+
+// Answer count queries into results[]. Large batches are answered in order of
+// their left endpoint, so consecutive queries walk mostly the same paths and
+// find those nodes already in cache; results[i] still answers queries[i].
+// Returns the number of invalid ranges.
+int rangeQuery_many(struct SegmentTree* st, const struct RangeQuery* queries, int count,
+                    struct RangeResult* results) {
+    int failures = 0;
+    int* order = count >= BATCH_SORT_MIN ? orderByLeft(&queries[0].l, sizeof(queries[0]), count) : NULL;
+    for (int i = 0; i < count; i++) {
+        int q = order != NULL ? order[i] : i;
+        failures += rangeQuery(st, queries[q].l, queries[q].r, &results[q]) != 0;
+    }
+    free(order);
+    return failures;
+}
+
+// Push every pending update down to the leaves, in O(n)
+static void pushAll(struct SegmentTree* st) {
+    for (int k = 1, len = st->size; k < st->size; k++) {
+        if ((k & (k - 1)) == 0 && k > 1) len >>= 1;  // First node of a new level
+        push(st, k, len);
+    }
+}
+
+// Apply count updates in order. Updates are order-dependent only around
+// assignments, so each run of consecutive adds is applied sorted by left
+// endpoint. A batch made only of adds that touches the tree more than about
+// once per element is applied in O(n + count) instead: pending updates are
+// pushed to the leaves, the adds are summed in a difference array, and the
+// tree is rebuilt. Returns the number of invalid ranges.
+int rangeUpdate_many(struct SegmentTree* st, const struct RangeUpdate* updates, int count) {
+    int failures = 0;
+    int onlyAdds = 1;
+    for (int i = 0; i < count; i++) {
+        if (updates[i].kind != UPDATE_ADD) onlyAdds = 0;
+    }
+
+    long long* diff = NULL;
+    if (onlyAdds && (long long)count * st->log >= st->n) {
+        diff = (long long*)calloc((size_t)st->n + 1, sizeof(long long));
+    }
+    if (diff != NULL) {
+        for (int i = 0; i < count; i++) {
+            const struct RangeUpdate* u = &updates[i];
+            if (u->l < 0 || u->r > st->n || u->l > u->r) {
+                failures++;
+                continue;
+            }
+            diff[u->l] += u->value;
+            diff[u->r] -= u->value;
+        }
+        pushAll(st);
+        long long running = 0;
+        for (int i = 0; i < st->n; i++) {
+            running += diff[i];
+            int k = st->size + i;
+            int v = st->min[k] + (int)running;
+            st->sum[k] = v;
+            st->min[k] = st->max[k] = v;
+        }
+        for (int k = st->size - 1; k >= 1; k--) {
+            pull(st, k);
+        }
+        free(diff);
+        return failures;
+    }
+
+    int start = 0;
+    while (start < count) {
+        if (updates[start].kind != UPDATE_ADD) {
+            failures += rangeUpdate(st, updates[start].l, updates[start].r, updates[start].kind, updates[start].value) != 0;
+            start++;
+            continue;
+        }
+        int end = start;
+        while (end < count && updates[end].kind == UPDATE_ADD) end++;
+        int* order = end - start >= BATCH_SORT_MIN
+            ? orderByLeft(&updates[start].l, sizeof(updates[0]), end - start) : NULL;
+        for (int i = 0; i < end - start; i++) {
+            const struct RangeUpdate* u = &updates[start + (order != NULL ? order[i] : i)];
+            failures += rangeUpdate(st, u->l, u->r, UPDATE_ADD, u->value) != 0;
+        }
+        free(order);
+        start = end;
+    }
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// A random range of up to maxSpan elements
+static void randomRange(uint64_t* seed, int n, int maxSpan, int* l, int* r) {
+    int span = 1 + (int)(nextRandom(seed) % (uint64_t)maxSpan);
+    if (span > n) span = n;
+    *l = (int)(nextRandom(seed) % (uint64_t)(n - span + 1));
+    *r = *l + span;
+}
+
+static void runBenchmark(int n, int ops) {
+    struct SegmentTree st;
+    struct RangeResult result;
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    int maxSpan = n / 100 > 1 ? n / 100 : 1;
+    long long checksum = 0;
+
+    int size = 1;
+    while (size < n) size *= 2;
+    printf("n = %d (%d leaves, about %.0f MB)\n", n, size,
+           ((double)size * 2 * (sizeof(long long) + 2 * sizeof(int)) + (double)size * (2 * sizeof(int) + 1)) / 1e6);
+
+    int* values = (int*)malloc((size_t)n * sizeof(int));
+    struct RangeQuery* queries = (struct RangeQuery*)malloc((size_t)ops * sizeof(struct RangeQuery));
+    struct RangeUpdate* updates = (struct RangeUpdate*)malloc((size_t)ops * sizeof(struct RangeUpdate));
+    struct RangeResult* results = (struct RangeResult*)malloc((size_t)ops * sizeof(struct RangeResult));
+    if (values == NULL || queries == NULL || updates == NULL || results == NULL) {
+        printf("  skipped: not enough memory\n");
+        free(values); free(queries); free(updates); free(results);
+        return;
+    }
+    for (int i = 0; i < n; i++) values[i] = (int)(nextRandom(&seed) % 1000);
+    for (int i = 0; i < ops; i++) {
+        randomRange(&seed, n, maxSpan, &queries[i].l, &queries[i].r);
+        randomRange(&seed, n, maxSpan, &updates[i].l, &updates[i].r);
+        updates[i].kind = UPDATE_ADD;
+        updates[i].value = (int)(nextRandom(&seed) % 7) - 3;
+    }
+
+    double t0 = nowSeconds();
+    if (initSegmentTree(&st, values, n) != 0) {
+        printf("  skipped: not enough memory\n");
+        free(values); free(queries); free(updates); free(results);
+        return;
+    }
+    double build = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (int i = 0; i < ops; i++) {
+        rangeQuery(&st, queries[i].l, queries[i].r, &result);
+        checksum += result.sum + result.min + result.max;
+    }
+    double query = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    rangeQuery_many(&st, queries, ops, results);
+    double queryBatch = nowSeconds() - t0;
+    for (int i = 0; i < ops; i++) checksum -= results[i].sum + results[i].min + results[i].max;
+
+    t0 = nowSeconds();
+    for (int i = 0; i < ops; i++) {
+        rangeAdd(&st, updates[i].l, updates[i].r, updates[i].value);
+    }
+    double add = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    rangeUpdate_many(&st, updates, ops);
+    double addBatch = nowSeconds() - t0;
+
+    // Alternate assignments and adds, with queries in between
+    t0 = nowSeconds();
+    for (int i = 0; i < ops; i++) {
+        if (i & 1) {
+            rangeAssign(&st, updates[i].l, updates[i].r, i & 1023);
+        } else {
+            rangeAdd(&st, updates[i].l, updates[i].r, 1);
+        }
+        rangeQuery(&st, queries[i].l, queries[i].r, &result);
+    }
+    double mixed = nowSeconds() - t0;
+
+    if (checksum != 0) printf("  batch results differ from single queries\n");
+    printf("  %-34s %14.2f s\n", "build", build);
+    printf("  %-34s %14s\n", "operation", "ops/sec");
+    printf("  %-34s %14.0f\n", "rangeQuery", ops / query);
+    printf("  %-34s %14.0f\n", "rangeQuery_many", ops / queryBatch);
+    printf("  %-34s %14.0f\n", "rangeAdd", ops / add);
+    printf("  %-34s %14.0f\n", "rangeUpdate_many (adds)", ops / addBatch);
+    printf("  %-34s %14.0f\n", "assign/add + query pairs", 2.0 * ops / mixed);
+
+    destroySegmentTree(&st);
+    free(values); free(queries); free(updates); free(results);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // --bench [n...]: defaults to 1M and 100M elements
+        int ops = 1000000;
+        if (argc > 2) {
+            for (int i = 2; i < argc; i++) runBenchmark(atoi(argv[i]), ops);
+        } else {
+            runBenchmark(1000000, ops);
+            runBenchmark(100000000, ops);
+        }
+        return 0;
+    }
+
+    int values[] = {5, 3, 8, 6, 1, 4, 7, 2};
+    int n = sizeof(values) / sizeof(values[0]);
+    struct SegmentTree st;
+    struct RangeResult r;
+    initSegmentTree(&st, values, n);
+
+    rangeQuery(&st, 0, n, &r);
+    printf("Whole array: sum %lld, min %d, max %d\n", r.sum, r.min, r.max);
+    rangeQuery(&st, 2, 6, &r);
+    printf("Range [2, 6): sum %lld, min %d, max %d\n", r.sum, r.min, r.max);
+
+    rangeAdd(&st, 1, 5, 10);
+    rangeQuery(&st, 0, n, &r);
+    printf("After adding 10 to [1, 5): sum %lld, min %d, max %d\n", r.sum, r.min, r.max);
+
+    rangeAssign(&st, 3, 8, 0);
+    rangeAdd(&st, 4, 6, 2);
+    rangeQuery(&st, 0, n, &r);
+    printf("After assigning 0 to [3, 8) and adding 2 to [4, 6): sum %lld, min %d, max %d\n", r.sum, r.min, r.max);
+
+    struct RangeQuery queries[] = {{0, 2}, {2, 4}, {4, 8}};
+    struct RangeResult results[3];
+    rangeQuery_many(&st, queries, 3, results);
+    for (int i = 0; i < 3; i++) {
+        printf("Sum of [%d, %d): %lld\n", queries[i].l, queries[i].r, results[i].sum);
+    }
+
+    destroySegmentTree(&st);
+    return 0;
+}